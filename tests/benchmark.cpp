@@ -0,0 +1,711 @@
+#include "../valdox.hpp"
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Build with optimizations, e.g. g++ -std=c++20 -O2 -march=native tests/benchmark.cpp -o benchmark
+
+static volatile bool benchmarkSink;
+
+template <typename Fn> static double nsPerCall(size_t iterations, Fn&& fn)
+{
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < iterations; ++i) benchmarkSink = fn(i);
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iterations);
+}
+
+static void report(const char* name, double before, double after)
+{
+	std::printf("%-40s %12.1f ns %12.1f ns %8.1fx\n", name, before, after, before / after);
+}
+
+static void header(const char* title, const char* before, const char* after)
+{
+	std::printf("\n%-40s %15s %15s %9s\n", title, before, after, "speedup");
+}
+
+// Compares a fresh std::regex per call (the previous behavior) against the validator's compiled pattern
+template <typename V> static void benchmarkFormat(const char* name, const V& validator, const std::vector<std::string>& values)
+{
+	const size_t iterations = 20000;
+	double before = nsPerCall(iterations,
+		[&](size_t i) { return std::regex_match(values[i % values.size()], std::regex(validator.getPattern())); });
+	double after = nsPerCall(iterations, [&](size_t i) { return validator.validate(values[i % values.size()]); });
+	report(name, before, after);
+}
+
+static void benchmarkCompiledFormats()
+{
+	Validator v;
+	header("format validators", "regex per call", "compiled once");
+	benchmarkFormat("email", v.string.email(), {"test@example.com", "user.name@domain.co.uk", "notanemail"});
+	benchmarkFormat("uuid", v.string.uuid(), {"123e4567-e89b-12d3-a456-426614174000", "not-a-uuid"});
+	benchmarkFormat("url", v.string.url(), {"https://example.com/path?q=1", "ftp://example.com"});
+	benchmarkFormat("dateTime.global", v.string.dateTime().global(EDateTimeOffset::Optional),
+		{"2023-12-25T10:30:00.123+05:00", "2023-12-25"});
+	benchmarkFormat("dateTime.local", v.string.dateTime().local(), {"2023-12-25T10:30:00", "2023-12-25T24:00:00"});
+	benchmarkFormat("date", v.string.date(), {"2023-12-25", "2023-13-01"});
+	benchmarkFormat("time", v.string.time(), {"10:30:00.123", "24:00"});
+	benchmarkFormat("ipv4", v.string.ip(EIpVersion::Ipv4, true), {"192.168.1.1/24", "256.1.1.1"});
+	benchmarkFormat("ipv6", v.string.ip(EIpVersion::Ipv6), {"2001:db8:85a3::8a2e:370:7334", "not-an-ipv6"});
+	benchmarkFormat("mac", v.string.mac(), {"00:11:22:33:44:55", "00-11-22-33-44-55"});
+}
+
+// Compares the precompiled regex against a hand-written scanner
+template <typename V> static void benchmarkScanner(const char* name, const V& validator, const std::vector<std::string>& values)
+{
+	const size_t iterations = 1000000;
+	const std::regex regex(validator.getPattern());
+	double before = nsPerCall(iterations, [&](size_t i) { return std::regex_match(values[i % values.size()], regex); });
+	double after = nsPerCall(iterations, [&](size_t i) { return validator.validate(values[i % values.size()]); });
+	report(name, before, after);
+}
+
+static void benchmarkScanners()
+{
+	Validator v;
+	header("format scanners", "compiled regex", "scanner");
+	benchmarkScanner("uuid", v.string.uuid(),
+		{"123e4567-e89b-12d3-a456-426614174000", "550e8400-e29b-41d4-a716-446655440000", "123e4567-e89b-02d3-a456-426614174000"});
+	benchmarkScanner("ipv4", v.string.ip(EIpVersion::Ipv4), {"192.168.1.1", "10.0.0.254", "256.1.1.1"});
+	benchmarkScanner("ipv4/prefix", v.string.ip(EIpVersion::Ipv4, true), {"192.168.1.0/24", "10.0.0.0/8", "10.0.0.0/33"});
+	benchmarkScanner("ipv6", v.string.ip(EIpVersion::Ipv6), {"2001:db8:85a3::8a2e:370:7334", "::1", "fe80::1ff:fe23:4567:890a"});
+	benchmarkScanner("ipv6/prefix", v.string.ip(EIpVersion::Ipv6, true), {"2001:db8::/32", "fe80::/10", "2001:db8::/129"});
+	benchmarkScanner("dateTime.global", v.string.dateTime().global(EDateTimeOffset::Optional),
+		{"2023-12-25T10:30:00.123+05:00", "2023-12-25T10:30:00Z", "2023-02-31T10:30:00"});
+	benchmarkScanner("dateTime.local", v.string.dateTime().local(), {"2023-12-25T10:30:00", "2023-12-25T24:00:00"});
+	benchmarkScanner("date", v.string.date(), {"2023-12-25", "2024-02-29", "2023-13-01"});
+	benchmarkScanner("time", v.string.time(), {"10:30:00.123", "23:59", "24:00"});
+}
+
+static void benchmarkRegexCache()
+{
+	Validator v;
+	const std::string pattern = "^([a-z0-9._-]+)@([a-z0-9-]+)\\.([a-z]{2,})$";
+	auto validator = v.string.regex(pattern);
+	const std::vector<std::string> values = {"john.doe@example.com", "invalid@", "a@b.io"};
+	const size_t iterations = 20000;
+
+	header("regex()", "regex per call", "cached");
+	double before = nsPerCall(
+		iterations, [&](size_t i) { return std::regex_match(values[i % values.size()], std::regex(pattern)); });
+	double after = nsPerCall(iterations, [&](size_t i) { return validator.validate(values[i % values.size()]); });
+	report("validate", before, after);
+	auto stats = regexCache().stats();
+	std::printf("cache hits %zu, misses %zu, evictions %zu\n", stats.hits, stats.misses, stats.evictions);
+}
+
+static void benchmarkRegexEngines()
+{
+	Validator v;
+	header("regex engines", "std::regex", "linear");
+	const std::vector<std::string> emails = {"john.doe@example.com", "invalid@", "a@b.io"};
+	const std::string email = "^([a-z0-9._-]+)@([a-z0-9-]+)\\.([a-z]{2,})$";
+	auto standard = v.string.regex(email);
+	auto linear = v.string.regex(email, ERegexEngine::Linear);
+	report("email",
+		nsPerCall(100000, [&](size_t i) { return standard.validate(emails[i % emails.size()]); }),
+		nsPerCall(100000, [&](size_t i) { return linear.validate(emails[i % emails.size()]); }));
+
+	// Exponential backtracking on (a+)+ for std::regex
+	const std::string hostile = std::string(20, 'a') + "!";
+	auto standardHostile = v.string.regex("^(a+)+$");
+	auto linearHostile = v.string.regex("^(a+)+$", ERegexEngine::Linear);
+	report("(a+)+ on 20 a's", nsPerCall(3, [&](size_t) { return standardHostile.validate(hostile); }),
+		nsPerCall(1000, [&](size_t) { return linearHostile.validate(hostile); }));
+}
+
+static void benchmarkRegexPrefilter()
+{
+	Validator v;
+	const std::string pattern = "^([a-z0-9._-]+)@([a-z0-9-]+)\\.([a-z]{2,})$";
+	auto validator = v.string.regex(pattern);
+	const std::regex regex(pattern);
+	// mostly rejected traffic: no '@'
+	const std::vector<std::string> values = {"john.doe.example.com", "user-name", "a.b.io", "john.doe@example.com"};
+	const size_t iterations = 200000;
+
+	header("regex() prefilter", "compiled regex", "prefiltered");
+	report("mostly missing '@'",
+		nsPerCall(iterations, [&](size_t i) { return std::regex_match(values[i % values.size()], regex); }),
+		nsPerCall(iterations, [&](size_t i) { return validator.validate(values[i % values.size()]); }));
+}
+
+static void benchmarkStartsWithAny()
+{
+	Validator v;
+	std::vector<std::string> prefixes;
+	for (int i = 0; i < 300; ++i) prefixes.push_back("/api/v" + std::to_string(i % 10) + "/service" + std::to_string(i) + "/");
+	std::vector<StringStartsWithValidator> validators;
+	for (const auto& prefix : prefixes) validators.push_back(v.string.startsWith(prefix));
+	auto trie = v.string.startsWithAny(prefixes);
+	const std::vector<std::string> values = {"/api/v7/service137/orders/42", "/api/v2/unknown/orders", "/static/app.js"};
+	const size_t iterations = 200000;
+
+	header("startsWithAny, 300 prefixes", "startsWith each", "trie");
+	report("validate",
+		nsPerCall(iterations,
+			[&](size_t i)
+			{
+				for (const auto& validator : validators)
+					if (validator.validate(values[i % values.size()])) return true;
+				return false;
+			}),
+		nsPerCall(iterations, [&](size_t i) { return trie.validate(values[i % values.size()]); }));
+}
+
+struct BenchmarkUser
+{
+	int age;
+	std::string name;
+	std::string email;
+	std::vector<int> scores;
+};
+
+static ValidatorBuilder<BenchmarkUser> benchmarkUserBuilder()
+{
+	Validator v;
+	ValidatorBuilder<BenchmarkUser> builder;
+	builder.add("age", &BenchmarkUser::age, v.number.between(0, 120));
+	builder.add("name", &BenchmarkUser::name, v.string.length.between(1, 50));
+	builder.add("email", &BenchmarkUser::email, v.string.email());
+	builder.addVector("scores", &BenchmarkUser::scores, v.number.between(0, 100));
+	return builder;
+}
+
+// reject-heavy traffic
+static const std::vector<BenchmarkUser> benchmarkUsers = {{150, "", "not-an-email", {101, 5}},
+	{-1, "John Doe", "john@example.com", {}}, {25, "John Doe", "john@example.com", {50, 60}}};
+
+static void benchmarkBuilderPredicate()
+{
+	const auto builder = benchmarkUserBuilder();
+	const auto& users = benchmarkUsers;
+	const size_t iterations = 100000;
+
+	header("ValidatorBuilder::validate(obj)", "error path", "predicate");
+	report("mostly rejected",
+		nsPerCall(iterations,
+			[&](size_t i)
+			{
+				std::vector<std::string> errors;
+				return builder.validate(users[i % users.size()], "", errors);
+			}),
+		nsPerCall(iterations, [&](size_t i) { return builder.validate(users[i % users.size()]); }));
+}
+
+static void benchmarkStructuredErrors()
+{
+	const auto builder = benchmarkUserBuilder();
+	const auto& users = benchmarkUsers;
+	const size_t iterations = 100000;
+
+	header("ValidatorBuilder error path", "messages", "records/sink");
+	report("mostly rejected",
+		nsPerCall(iterations,
+			[&](size_t i)
+			{
+				std::vector<std::string> errors;
+				return builder.validate(users[i % users.size()], "user", errors);
+			}),
+		nsPerCall(iterations,
+			[&](size_t i)
+			{
+				std::vector<ValidationError> errors;
+				return builder.validate(users[i % users.size()], "user", errors);
+			}));
+
+	CountingErrorSink sink;
+	report("mostly rejected, counting sink",
+		nsPerCall(iterations,
+			[&](size_t i)
+			{
+				std::vector<std::string> errors;
+				return builder.validate(users[i % users.size()], "user", errors);
+			}),
+		nsPerCall(iterations, [&](size_t i) { return builder.validate(users[i % users.size()], "user", sink); }));
+}
+
+static void benchmarkMessageFormatting()
+{
+	Validator v;
+	auto price = v.number.between(0.0, 1000.0);
+	auto quantity = v.number.between(1, 100);
+	// bulk import, half the rows invalid
+	std::vector<double> prices;
+	std::vector<int> quantities;
+	for (int i = 0; i < 1000; ++i)
+	{
+		prices.push_back(i % 2 ? 12.5 * i : -0.37 * i);
+		quantities.push_back(i % 2 ? 1 + i % 100 : 100 + i);
+	}
+	const size_t iterations = 200000;
+
+	header("error messages, half invalid", "ostringstream", "to_chars");
+	report("number.between(double)",
+		nsPerCall(iterations,
+			[&](size_t i)
+			{
+				std::vector<std::string> errors;
+				const double value = prices[i % prices.size()];
+				if (price.validate(value)) return true;
+				std::ostringstream errorMessage;
+				errorMessage << "ValidationError: '" << "price" << "' received " << value << ", expected " << price.min
+							 << " <= {value} <= " << price.max << ".";
+				errors.push_back(errorMessage.str());
+				return false;
+			}),
+		nsPerCall(iterations,
+			[&](size_t i)
+			{
+				std::vector<std::string> errors;
+				return price.validate(prices[i % prices.size()], "price", errors);
+			}));
+	report("number.between(int)",
+		nsPerCall(iterations,
+			[&](size_t i)
+			{
+				std::vector<std::string> errors;
+				const int value = quantities[i % quantities.size()];
+				if (quantity.validate(value)) return true;
+				std::ostringstream errorMessage;
+				errorMessage << "ValidationError: '" << "quantity" << "' received " << value << ", expected " << quantity.min
+							 << " <= {value} <= " << quantity.max << ".";
+				errors.push_back(errorMessage.str());
+				return false;
+			}),
+		nsPerCall(iterations,
+			[&](size_t i)
+			{
+				std::vector<std::string> errors;
+				return quantity.validate(quantities[i % quantities.size()], "quantity", errors);
+			}));
+}
+
+struct BenchmarkOrder
+{
+	int id;
+	int quantity;
+	double price;
+	double discount;
+	std::string currency;
+	std::string sku;
+};
+
+static void benchmarkSchema()
+{
+	Validator v;
+	ValidatorBuilder<BenchmarkOrder> builder;
+	builder.add("id", &BenchmarkOrder::id, v.number.greaterThan(0));
+	builder.add("quantity", &BenchmarkOrder::quantity, v.number.between(1, 1000));
+	builder.add("price", &BenchmarkOrder::price, v.number.greaterOrEqual(0.0));
+	builder.add("discount", &BenchmarkOrder::discount, v.number.between(0.0, 1.0));
+	builder.add("currency", &BenchmarkOrder::currency, v.string.length.between(3, 3));
+	builder.add("sku", &BenchmarkOrder::sku, v.string.startsWith("SKU-"));
+	auto schema = makeSchema<BenchmarkOrder>(v.field("id", &BenchmarkOrder::id, v.number.greaterThan(0)),
+		v.field("quantity", &BenchmarkOrder::quantity, v.number.between(1, 1000)),
+		v.field("price", &BenchmarkOrder::price, v.number.greaterOrEqual(0.0)),
+		v.field("discount", &BenchmarkOrder::discount, v.number.between(0.0, 1.0)),
+		v.field("currency", &BenchmarkOrder::currency, v.string.length.between(3, 3)),
+		v.field("sku", &BenchmarkOrder::sku, v.string.startsWith("SKU-")));
+	const std::vector<BenchmarkOrder> valid = {{1, 5, 9.99, 0.1, "EUR", "SKU-1"}, {2, 1, 100.0, 0.0, "USD", "SKU-22"}};
+	const std::vector<BenchmarkOrder> invalid = {{1, 5, 9.99, 0.1, "EUR", "ITEM-1"}, {2, 0, 100.0, 0.0, "USD", "SKU-22"}};
+	const size_t iterations = 2000000;
+
+	header("6-field object", "ValidatorBuilder", "makeSchema");
+	report("valid", nsPerCall(iterations, [&](size_t i) { return builder.validate(valid[i % valid.size()]); }),
+		nsPerCall(iterations, [&](size_t i) { return schema.validate(valid[i % valid.size()]); }));
+	report("invalid", nsPerCall(iterations, [&](size_t i) { return builder.validate(invalid[i % invalid.size()]); }),
+		nsPerCall(iterations, [&](size_t i) { return schema.validate(invalid[i % invalid.size()]); }));
+}
+
+static void benchmarkExpressions()
+{
+	Validator v;
+	AndValidator<int> andValidator;
+	andValidator.add(v.number.between(0, 100));
+	andValidator.add(v.number.multipleOf(5));
+	OrValidator<int> orValidator;
+	orValidator.add(andValidator);
+	orValidator.add(v.number.literals<int>({-1, 999}));
+	auto expression = (v.number.between(0, 100) && v.number.multipleOf(5)) || v.number.literals<int>({-1, 999});
+	const size_t iterations = 5000000;
+
+	header("(between && multipleOf) || literals", "And/OrValidator", "expression");
+	report("validate", nsPerCall(iterations, [&](size_t i) { return orValidator.validate(static_cast<int>(i % 1024)); }),
+		nsPerCall(iterations, [&](size_t i) { return expression.validate(static_cast<int>(i % 1024)); }));
+}
+
+static void benchmarkAnyValidator()
+{
+	Validator v;
+	const auto between = v.number.between(0, 1000);
+	const auto multipleOf = v.number.multipleOf(3);
+	const auto literals = v.number.literals<int>({-1, 7, 42});
+	const size_t iterations = 200000;
+
+	header("runtime composition, 3 rules", "std::function", "AnyValidator");
+	report("build and copy",
+		nsPerCall(iterations,
+			[&](size_t)
+			{
+				std::vector<std::function<bool(const int&)>> rules;
+				rules.reserve(3);
+				rules.emplace_back([=](const int& value) { return between.validate(value); });
+				rules.emplace_back([=](const int& value) { return multipleOf.validate(value); });
+				rules.emplace_back([=](const int& value) { return literals.validate(value); });
+				auto copy = rules;
+				return copy.size() == 3;
+			}),
+		nsPerCall(iterations,
+			[&](size_t)
+			{
+				std::vector<AnyValidator<int>> rules;
+				rules.reserve(3);
+				rules.emplace_back(between);
+				rules.emplace_back(multipleOf);
+				rules.emplace_back(literals);
+				auto copy = rules;
+				return copy.size() == 3;
+			}));
+
+	std::vector<std::function<bool(const int&)>> functions = {[=](const int& value) { return between.validate(value); },
+		[=](const int& value) { return multipleOf.validate(value); }, [=](const int& value) { return literals.validate(value); }};
+	std::vector<AnyValidator<int>> validators = {between, multipleOf, literals};
+	report("validate",
+		nsPerCall(iterations * 10,
+			[&](size_t i)
+			{
+				for (const auto& function : functions)
+					if (!function(static_cast<int>(i % 2000))) return false;
+				return true;
+			}),
+		nsPerCall(iterations * 10,
+			[&](size_t i)
+			{
+				for (const auto& validator : validators)
+					if (!validator.validate(static_cast<int>(i % 2000))) return false;
+				return true;
+			}));
+}
+
+static void benchmarkNormalize()
+{
+	Validator v;
+	const std::vector<AnyValidator<int>> children
+		= {v.number.greaterThan(0), v.number.greaterOrEqual(10), v.number.lessThan(1000), v.number.lessOrEqual(500)};
+	AndValidator<int> inner;
+	inner.add(v.number.greaterOrEqual(10));
+	inner.add(v.number.lessThan(1000));
+	AndValidator<int> andValidator;
+	andValidator.add(v.number.greaterThan(0));
+	andValidator.add(inner);
+	andValidator.add(v.number.lessOrEqual(500));
+	const size_t iterations = 5000000;
+
+	header("4 numeric bounds, one nested And", "one by one", "normalized");
+	report("validate",
+		nsPerCall(iterations,
+			[&](size_t i)
+			{
+				for (const auto& child : children)
+					if (!child.validate(static_cast<int>(i % 1024))) return false;
+				return true;
+			}),
+		nsPerCall(iterations, [&](size_t i) { return andValidator.validate(static_cast<int>(i % 1024)); }));
+}
+
+static void benchmarkAdaptiveOrder()
+{
+	Validator v;
+	AndValidator<std::string> fixed;
+	fixed.add(v.string.regex("^[a-z0-9-]+$"));
+	fixed.add(v.string.startsWith("sku-"));
+	AndValidator<std::string> adaptive = fixed;
+	adaptive.enableAdaptiveOrder();
+	const std::vector<std::string> values = {"order-1234-abcd", "item-77", "sku-1234-abcd", "user-42-x", "batch-9"};
+	const size_t iterations = 200000;
+
+	header("regex && startsWith, mostly rejected", "insertion order", "adaptive");
+	report("validate", nsPerCall(iterations, [&](size_t i) { return fixed.validate(values[i % values.size()]); }),
+		nsPerCall(iterations, [&](size_t i) { return adaptive.validate(values[i % values.size()]); }));
+}
+
+// Scalar validate() per value, packing the same bitmask, against validateBatch over a column of 10^6 values
+template <typename T, typename V>
+static void benchmarkBatchColumn(const char* name, const V& validator, const std::vector<T>& column)
+{
+	std::vector<uint64_t> passed((column.size() + 63) / 64);
+	const size_t iterations = 20;
+	double before = nsPerCall(iterations,
+						[&](size_t)
+						{
+							std::fill(passed.begin(), passed.end(), 0);
+							size_t failures = 0;
+							for (size_t i = 0; i < column.size(); ++i)
+							{
+								const bool bValid = validator.validate(column[i]);
+								passed[i / 64] |= static_cast<uint64_t>(bValid) << (i % 64);
+								failures += !bValid;
+							}
+							return failures == 0;
+						})
+		/ static_cast<double>(column.size());
+	double after = nsPerCall(iterations, [&](size_t) { return validator.validateBatch(column, passed) == 0; })
+		/ static_cast<double>(column.size());
+	report(name, before, after);
+}
+
+static void benchmarkBatch()
+{
+	Validator v;
+	std::vector<float> floats(1000000);
+	std::vector<int32_t> ints(1000000);
+	for (size_t i = 0; i < floats.size(); ++i)
+	{
+		floats[i] = static_cast<float>((i * 7919) % 1000) / 10.0f - 5.0f;
+		ints[i] = static_cast<int32_t>((i * 7919) % 1000) - 50;
+	}
+
+	header("10^6 values, ns per value", "validate loop", "validateBatch");
+	benchmarkBatchColumn("float between", v.number.between(0.0f, 90.0f), floats);
+	benchmarkBatchColumn("float greaterThan", v.number.greaterThan(0.0f), floats);
+	benchmarkBatchColumn("int32 between", v.number.between(0, 900), ints);
+	benchmarkBatchColumn("int32 lessOrEqual", v.number.lessOrEqual(900), ints);
+}
+
+static void benchmarkClamp()
+{
+	Validator v;
+	std::vector<float> frame(1000000);
+	std::vector<int32_t> counts(1000000);
+	for (size_t i = 0; i < frame.size(); ++i)
+	{
+		frame[i] = static_cast<float>((i * 7919) % 1000) / 10.0f - 5.0f;
+		counts[i] = static_cast<int32_t>((i * 7919) % 1000) - 50;
+	}
+	std::vector<float> floatsOut(frame.size());
+	std::vector<int32_t> intsOut(counts.size());
+	const auto floatRange = v.number.between(0.0f, 90.0f, false, true);
+	const auto intRange = v.number.between(0, 900);
+	const size_t iterations = 20;
+	const double size = static_cast<double>(frame.size());
+
+	header("clamp 10^6 values, ns per value", "clamp loop", "bulk clamp");
+	report("float",
+		nsPerCall(iterations,
+			[&](size_t)
+			{
+				for (size_t i = 0; i < frame.size(); ++i) floatsOut[i] = floatRange.clamp(frame[i]);
+				return floatsOut[0] > 0;
+			})
+			/ size,
+		nsPerCall(iterations,
+			[&](size_t)
+			{
+				floatRange.clamp(frame, floatsOut);
+				return floatsOut[0] > 0;
+			})
+			/ size);
+	report("int32",
+		nsPerCall(iterations,
+			[&](size_t)
+			{
+				for (size_t i = 0; i < counts.size(); ++i) intsOut[i] = intRange.clamp(counts[i]);
+				return intsOut[0] > 0;
+			})
+			/ size,
+		nsPerCall(iterations,
+			[&](size_t)
+			{
+				intRange.clamp(counts, intsOut);
+				return intsOut[0] > 0;
+			})
+			/ size);
+}
+
+static void benchmarkMultipleOf()
+{
+	Validator v;
+	std::vector<int32_t> ints(1000000);
+	std::vector<int64_t> longs(1000000);
+	for (size_t i = 0; i < ints.size(); ++i)
+	{
+		ints[i] = static_cast<int32_t>(i * 2654435761u) - 1000;
+		longs[i] = static_cast<int64_t>(i * 11400714819323198485ull);
+	}
+	// divisors only known at run time, as when they come from configuration
+	volatile int32_t seven = 7;
+	volatile int64_t twelve = 12;
+	const auto ints7 = v.number.multipleOf(static_cast<int32_t>(seven));
+	const auto longs12 = v.number.multipleOf(static_cast<int64_t>(twelve));
+	const size_t iterations = 20;
+	const double size = static_cast<double>(ints.size());
+	auto moduloLoop = [&](const auto& column, auto divisor)
+	{
+		size_t failures = 0;
+		for (auto value : column) failures += value % divisor != 0;
+		return failures;
+	};
+	auto validateLoop = [&](const auto& column, const auto& validator)
+	{
+		size_t failures = 0;
+		for (auto value : column) failures += !validator.validate(value);
+		return failures;
+	};
+
+	header("multipleOf, 10^6 values, ns per value", "% per value", "precomputed");
+	const double intsModulo
+		= nsPerCall(iterations, [&](size_t) { return moduloLoop(ints, static_cast<int32_t>(seven)) == 0; }) / size;
+	const double longsModulo
+		= nsPerCall(iterations, [&](size_t) { return moduloLoop(longs, static_cast<int64_t>(twelve)) == 0; }) / size;
+	report("int32 validate", intsModulo, nsPerCall(iterations, [&](size_t) { return validateLoop(ints, ints7) == 0; }) / size);
+	report("int64 validate",
+		longsModulo,
+		nsPerCall(iterations, [&](size_t) { return validateLoop(longs, longs12) == 0; }) / size);
+	std::vector<uint64_t> passed((ints.size() + 63) / 64);
+	report("int32 validateBatch", intsModulo,
+		nsPerCall(iterations, [&](size_t) { return ints7.validateBatch(ints, passed) == 0; }) / size);
+}
+
+static void benchmarkNumberLiterals()
+{
+	static const char* lookupNames[] = {"scan", "bitmap", "sorted", "hash"};
+	Validator v;
+	std::mt19937 random(1);
+	std::vector<int32_t> probes(4096);
+
+	header("literals, ns per lookup", "linear scan", "adaptive");
+	for (size_t size : {2, 4, 8, 16, 32, 64, 128, 512, 4096})
+	{
+		for (bool bDense : {false, true})
+		{
+			// sparse: random values; dense: status-code like values in a compact range
+			std::vector<int32_t> lits;
+			for (size_t i = 0; i < size; ++i)
+				lits.push_back(bDense ? static_cast<int32_t>(100 + 2 * i) : static_cast<int32_t>(random() % 1000000000));
+			// half of the probes are members
+			for (size_t i = 0; i < probes.size(); ++i)
+				probes[i] = i % 2 ? lits[random() % size] : static_cast<int32_t>(bDense ? 100 + random() % (3 * size) : random());
+			const auto validator = v.number.literals<int32_t>(lits);
+			const size_t iterations = 2000000;
+			char name[64];
+			std::snprintf(name, sizeof(name), "%zu %s (%s)", size, bDense ? "dense" : "sparse",
+				lookupNames[static_cast<int>(validator.getLookup())]);
+			report(name,
+				nsPerCall(iterations,
+					[&](size_t i)
+					{
+						const int32_t value = probes[i % probes.size()];
+						for (const auto& lit : validator.getLiterals())
+							if (value == lit) return true;
+						return false;
+					}),
+				nsPerCall(iterations, [&](size_t i) { return validator.validate(probes[i % probes.size()]); }));
+		}
+	}
+
+	// Crossovers behind ScanLimit and SortedLimit, on sparse sets where no bitmap applies
+	const std::vector<size_t> crossoverSizes = {2, 3, 4, 6, 8, 12, 16, 24, 32, 48, 64, 128};
+	for (auto [first, second] : {std::pair(ELiteralLookup::Scan, ELiteralLookup::Sorted),
+			 std::pair(ELiteralLookup::Sorted, ELiteralLookup::Hash)})
+	{
+		header("literals, ns per lookup", lookupNames[static_cast<int>(first)], lookupNames[static_cast<int>(second)]);
+		for (size_t size : crossoverSizes)
+		{
+			std::vector<int32_t> lits;
+			for (size_t i = 0; i < size; ++i) lits.push_back(static_cast<int32_t>(random() % 1000000000));
+			for (size_t i = 0; i < probes.size(); ++i) probes[i] = i % 2 ? lits[random() % size] : static_cast<int32_t>(random());
+			const NumberLiteralValidator<int32_t> before(lits, first);
+			const NumberLiteralValidator<int32_t> after(lits, second);
+			const size_t iterations = 2000000;
+			char name[64];
+			std::snprintf(name, sizeof(name), "%zu sparse", size);
+			report(name,
+				nsPerCall(iterations, [&](size_t i) { return before.validate(probes[i % probes.size()]); }),
+				nsPerCall(iterations, [&](size_t i) { return after.validate(probes[i % probes.size()]); }));
+		}
+	}
+}
+
+static void benchmarkStringLiterals()
+{
+	Validator v;
+	std::mt19937 random(5);
+	std::vector<std::string> probes(4096);
+
+	header("string literals, ns per lookup", "linear scan", "indexed");
+	for (size_t size : {4, 8, 32, 256, 1024, 8192})
+	{
+		for (bool bCodes : {true, false})
+		{
+			// currency-like 3-letter codes or product SKUs
+			std::vector<std::string> lits;
+			char buffer[32];
+			for (size_t i = 0; i < size; ++i)
+			{
+				if (bCodes)
+					std::snprintf(buffer,
+						sizeof(buffer),
+						"%c%c%c",
+						'A' + static_cast<int>(i / 676 % 26),
+						'A' + static_cast<int>(i / 26 % 26),
+						'A' + static_cast<int>(i % 26));
+				else
+					std::snprintf(buffer, sizeof(buffer), "SKU-%06u-%c%c", static_cast<unsigned>(random() % 1000000),
+						'A' + static_cast<int>(random() % 26), 'A' + static_cast<int>(random() % 26));
+				lits.push_back(buffer);
+			}
+			// half of the probes are members, the others differ in their last character
+			for (size_t i = 0; i < probes.size(); ++i)
+			{
+				probes[i] = lits[random() % size];
+				if (i % 2) probes[i].back() = 'z';
+			}
+			const auto validator = v.string.literals(lits);
+			const size_t iterations = size > 1000 ? 100000 : 1000000;
+			char name[64];
+			std::snprintf(name, sizeof(name), "%zu %s (%s)", size, bCodes ? "codes" : "SKUs",
+				validator.getLookup() == ELiteralLookup::Scan ? "scan" : "perfect hash");
+			report(name,
+				nsPerCall(iterations,
+					[&](size_t i)
+					{
+						const std::string& value = probes[i % probes.size()];
+						for (const auto& lit : validator.getLiterals())
+							if (value == lit) return true;
+						return false;
+					}),
+				nsPerCall(iterations, [&](size_t i) { return validator.validate(probes[i % probes.size()]); }));
+		}
+	}
+}
+
+int main()
+{
+	benchmarkCompiledFormats();
+	benchmarkRegexCache();
+	benchmarkScanners();
+	benchmarkRegexEngines();
+	benchmarkRegexPrefilter();
+	benchmarkStartsWithAny();
+	benchmarkBuilderPredicate();
+	benchmarkStructuredErrors();
+	benchmarkMessageFormatting();
+	benchmarkSchema();
+	benchmarkExpressions();
+	benchmarkAnyValidator();
+	benchmarkNormalize();
+	benchmarkAdaptiveOrder();
+	benchmarkBatch();
+	benchmarkClamp();
+	benchmarkMultipleOf();
+	benchmarkNumberLiterals();
+	benchmarkStringLiterals();
+	return 0;
+}
@@ -1,9 +1,57 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "../valdox.hpp"
 #include "doctest.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <random>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <variant>
 #include <vector>
 
+// Counts heap allocations so that tests can check allocation-free paths, not inlined so that the compiler does not pair
+// new expressions with malloc and free
+static std::atomic<size_t> allocationCount{0};
+
+[[gnu::noinline]] void* operator new(size_t size)
+{
+	++allocationCount;
+	if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+	throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	++allocationCount;
+	return std::malloc(size ? size : 1);
+}
+
+[[gnu::noinline]] void* operator new[](size_t size) { return operator new(size); }
+
+[[gnu::noinline]] void* operator new[](size_t size, const std::nothrow_t& tag) noexcept { return operator new(size, tag); }
+
+// Every form that can release the above is replaced too, so that sanitizers see matching allocation and deallocation
+[[gnu::noinline]] void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+[[gnu::noinline]] void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+[[gnu::noinline]] void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+
+[[gnu::noinline]] void operator delete[](void* ptr) noexcept { std::free(ptr); }
+
+[[gnu::noinline]] void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+
+[[gnu::noinline]] void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+
 // Number Validator Tests
 TEST_CASE("NumberBetweenValidator")
 {
@@ -249,6 +297,50 @@ TEST_CASE("StringEndsWithValidator")
 	CHECK_FALSE(errors.empty());
 }
 
+TEST_CASE("StringStartsWithAnyValidator")
+{
+	Validator v;
+	auto validator = v.string.startsWithAny({"/api/v1/", "/api/v2/", "/static/", "/api/", "/health"});
+
+	CHECK(validator.validate("/api/v1/users"));
+	CHECK(validator.validate("/api/v3/users"));
+	CHECK(validator.validate("/static/app.js"));
+	CHECK(validator.validate("/health"));
+	CHECK_FALSE(validator.validate("/healt"));
+	CHECK_FALSE(validator.validate("/ap"));
+	CHECK_FALSE(validator.validate(""));
+	CHECK_FALSE(validator.validate("api/v1/"));
+
+	std::vector<std::string> errors;
+	CHECK_FALSE(validator.validate("/admin", "path", errors));
+	CHECK(errors.size() == 1);
+	CHECK(errors[0].find("\"/static/\"") != std::string::npos);
+
+	CHECK(v.string.startsWithAny({""}).validate("anything"));
+	CHECK_FALSE(v.string.startsWithAny({}).validate("anything"));
+
+	// Matches a linear scan over hundreds of prefixes, without allocating
+	std::mt19937 rng(42);
+	std::vector<std::string> prefixes;
+	for (int i = 0; i < 300; ++i)
+	{
+		std::string prefix;
+		for (size_t length = 1 + rng() % 6; prefix.size() < length;) prefix += static_cast<char>('a' + rng() % 4);
+		prefixes.push_back(prefix);
+	}
+	auto many = v.string.startsWithAny(prefixes);
+	for (int i = 0; i < 2000; ++i)
+	{
+		std::string value;
+		for (size_t length = rng() % 9; value.size() < length;) value += static_cast<char>('a' + rng() % 5);
+		bool expected = false;
+		for (const auto& prefix : prefixes) expected = expected || std::string_view(value).starts_with(prefix);
+		size_t before = allocationCount;
+		CHECK(many.validate(value) == expected);
+		CHECK(allocationCount == before);
+	}
+}
+
 TEST_CASE("StringIncludesValidator")
 {
 	Validator v;
@@ -289,6 +381,309 @@ TEST_CASE("StringRegexValidator")
 	CHECK(matches[1] == "example");
 }
 
+TEST_CASE("StringRegexValidator - Linear Engine")
+{
+	Validator v;
+	auto validator = v.string.regex("^([a-z]+)@([a-z]+)\\.com$", ERegexEngine::Linear);
+
+	CHECK(validator.validate("test@example.com"));
+	CHECK_FALSE(validator.validate("test@example.org"));
+	std::vector<std::string> matches;
+	CHECK(validator.match("test@example.com", matches));
+	CHECK(matches.size() == 2);
+	CHECK(matches[0] == "test");
+	CHECK(matches[1] == "example");
+
+	std::vector<std::string> errors;
+	CHECK_FALSE(validator.validate("invalid", "email", errors));
+	CHECK(errors.size() == 1);
+
+	// Hostile input for a backtracking engine
+	auto nested = v.string.regex("^(a+)+$", ERegexEngine::Linear);
+	CHECK_FALSE(nested.validate(std::string(10000, 'a') + "b"));
+	CHECK(nested.validate(std::string(10000, 'a')));
+
+	// Unsupported or invalid syntax
+	CHECK_THROWS_AS(v.string.regex("(a)\\1", ERegexEngine::Linear), std::regex_error);
+	CHECK_THROWS_AS(v.string.regex("a(?=b)", ERegexEngine::Linear), std::regex_error);
+	CHECK_THROWS_AS(v.string.regex("a**", ERegexEngine::Linear), std::regex_error);
+	CHECK_THROWS_AS(v.string.regex("[b-a]", ERegexEngine::Linear), std::regex_error);
+	CHECK_THROWS_AS(v.string.regex("(a", ERegexEngine::Linear), std::regex_error);
+	CHECK_THROWS_AS(v.string.regex("a{2", ERegexEngine::Linear), std::regex_error);
+}
+
+TEST_CASE("StringRegexValidator - Linear Engine Matches std::regex")
+{
+	Validator v;
+	const std::vector<std::string> patterns = {"^[0-9]+$",
+		"(a|ab)(c|bcd)(d*)",
+		"(a+)+b",
+		"a{2,4}",
+		"a{2,}?b",
+		"(?:ab|a)(b*)",
+		"^(\\w+)\\s(\\d{1,3})$",
+		".*x.*",
+		"[^abc]+",
+		"(a|b)*c",
+		"((a)|b)+",
+		"\\bab\\b",
+		"a\\Bb",
+		"[a-c-]+",
+		"[\\d.]+",
+		"(a?)(a?)(a?)aaa",
+		"(.*?)-(.*)",
+		"\\x41\\u0042",
+		"a|",
+		"([a-z]*)([0-9]*)",
+		"(?:a{0,2}){2}b"};
+	const std::string alphabet = "abcdx -.09yzAB_";
+	std::mt19937 rng(11);
+
+	for (const auto& pattern : patterns)
+	{
+		auto linear = v.string.regex(pattern, ERegexEngine::Linear);
+		auto standard = v.string.regex(pattern);
+		for (int n = 0; n < 500; ++n)
+		{
+			std::string value;
+			for (size_t length = rng() % 9; length > 0; --length) value += alphabet[rng() % alphabet.size()];
+			std::vector<std::string> linearMatches, standardMatches;
+			REQUIRE_MESSAGE(linear.match(value, linearMatches) == standard.match(value, standardMatches), pattern, " ", value);
+			REQUIRE_MESSAGE(linearMatches == standardMatches, pattern, " ", value);
+		}
+	}
+
+	// Repeated groups that can match the empty string: same match results, but the linear engine skips the empty
+	// iteration that libstdc++ captures
+	const std::string nullablePatterns[] = {"(a*)*b", "(a|)*c", "(a?)*b?", "(|a)+"};
+	for (const auto& pattern : nullablePatterns)
+	{
+		auto linear = v.string.regex(pattern, ERegexEngine::Linear);
+		auto standard = v.string.regex(pattern);
+		for (int n = 0; n < 500; ++n)
+		{
+			std::string value;
+			for (size_t length = rng() % 9; length > 0; --length) value += "abc"[rng() % 3];
+			REQUIRE_MESSAGE(linear.validate(value) == standard.validate(value), pattern, " ", value);
+		}
+	}
+	std::vector<std::string> matches;
+	REQUIRE(v.string.regex("(a*)*b", ERegexEngine::Linear).match("aab", matches));
+	CHECK(matches == std::vector<std::string>{"aa"});
+}
+
+TEST_CASE("StringRegexValidator - String View Captures")
+{
+	Validator v;
+	const std::string line = "2024-05-01 ERROR [db] connection lost";
+	const std::string pattern = "^([0-9-]+) ([A-Z]+) \\[([a-z]+)\\] (.*)$";
+
+	for (ERegexEngine engine : {ERegexEngine::Std, ERegexEngine::Linear})
+	{
+		auto validator = v.string.regex(pattern, engine);
+		std::array<std::string_view, 4> captures;
+		size_t count = 0;
+		REQUIRE(validator.match(line, captures, count));
+		CHECK(count == 4);
+		CHECK(captures[0] == "2024-05-01");
+		CHECK(captures[1] == "ERROR");
+		CHECK(captures[2] == "db");
+		CHECK(captures[3] == "connection lost");
+		// Views point into the input
+		CHECK(captures[1].data() == line.data() + 11);
+
+		// Extra groups are dropped
+		std::array<std::string_view, 2> fewer;
+		CHECK(validator.match(line, fewer, count));
+		CHECK(count == 2);
+		CHECK(fewer[1] == "ERROR");
+
+		CHECK_FALSE(validator.match(std::string_view("not a log line"), captures, count));
+		CHECK(count == 0);
+
+		// Unmatched optional group
+		auto optional = v.string.regex("(a)?(b)", engine);
+		std::array<std::string_view, 2> groups;
+		CHECK(optional.match(std::string_view("b"), groups, count));
+		CHECK(count == 2);
+		CHECK(groups[0].empty());
+		CHECK(groups[1] == "b");
+	}
+
+	// No allocation with the linear engine once its buffers are warm
+	auto linear = v.string.regex(pattern, ERegexEngine::Linear);
+	std::array<std::string_view, 4> captures;
+	size_t count = 0;
+	linear.match(line, captures, count);
+	size_t before = allocationCount;
+	for (int i = 0; i < 100; ++i) linear.match(line, captures, count);
+	CHECK(allocationCount == before);
+}
+
+TEST_CASE("RegexPrefilter")
+{
+	auto email = RegexPrefilter::fromPattern("^([a-z]+)@([a-z]+)\\.com$");
+	CHECK(email.prefix.empty());
+	CHECK(email.suffix == ".com");
+	CHECK(email.required == std::vector<std::string>{".com", "@"});
+	CHECK(email.minLength == 7);
+
+	auto url = RegexPrefilter::fromPattern("https?://[a-z.]+/api/v[0-9]+");
+	CHECK(url.prefix == "http");
+	CHECK(url.suffix.empty());
+	CHECK(url.required == std::vector<std::string>{"/api/v", "http", "://"});
+
+	auto literal = RegexPrefilter::fromPattern("(?:abc){2}");
+	CHECK(literal.prefix == "abcabc");
+	CHECK(literal.required == std::vector<std::string>{"abcabc"});
+
+	auto alternate = RegexPrefilter::fromPattern("key-(one|two)|key-three");
+	CHECK(alternate.prefix == "key-");
+	CHECK(alternate.minLength == 7);
+
+	auto optional = RegexPrefilter::fromPattern("a(bc)?d");
+	CHECK(optional.required == std::vector<std::string>{"a", "d"});
+
+	// Syntax that RegexParser does not support accepts everything
+	auto backref = RegexPrefilter::fromPattern("(a)x\\1");
+	CHECK(backref.required.empty());
+	CHECK(backref.mayMatch("", true));
+
+	CHECK(email.mayMatch("test@example.com", true));
+	CHECK_FALSE(email.mayMatch("test.example.com", true));
+	CHECK_FALSE(email.mayMatch("test@example.org", true));
+	CHECK_FALSE(email.mayMatch("a@.com", true));
+}
+
+TEST_CASE("RegexPrefilter - Never Rejects A Match")
+{
+	const std::vector<std::string> patterns = {"^([a-z0-9._-]+)@([a-z0-9-]+)\\.([a-z]{2,})$",
+		"(a|ab)(c|bcd)(d*)",
+		"x(ab)+y",
+		"a{2,4}b{3}",
+		"(?:ab|ac)d",
+		"(.*?)-(.*)",
+		"[.]a[b]",
+		"(ab|cd)*e",
+		"a|",
+		"\\bab\\b"};
+	const std::string alphabet = "abcdexy-.@";
+	std::mt19937 rng(5);
+	for (const auto& pattern : patterns)
+	{
+		auto prefilter = RegexPrefilter::fromPattern(pattern);
+		const std::regex reference(pattern);
+		for (int n = 0; n < 3000; ++n)
+		{
+			std::string value;
+			for (size_t length = rng() % 10; length > 0; --length) value += alphabet[rng() % alphabet.size()];
+			if (std::regex_match(value, reference)) REQUIRE_MESSAGE(prefilter.mayMatch(value, true), pattern, " ", value);
+			if (std::regex_search(value, reference)) REQUIRE_MESSAGE(prefilter.mayMatch(value, false), pattern, " ", value);
+		}
+	}
+}
+
+TEST_CASE("StringRegexValidator - Prefilter With Custom Match Function")
+{
+	Validator v;
+	auto validator = v.string.regex("abc");
+	CHECK_FALSE(validator.validate("xxabcxx"));
+
+	// A custom engine with search semantics must still see values that only contain the literal
+	StringRegexMatchFn previous = stringRegexMatchFn;
+	stringRegexMatchFn = [](const std::string& regex, const std::string& value, std::vector<std::string>&)
+	{ return std::regex_search(value, std::regex(regex)); };
+	CHECK(validator.validate("xxabcxx"));
+	CHECK_FALSE(validator.validate("xxabxx"));
+
+	// Neither the minimum length nor the required literals reject values before a custom function runs
+	auto email = v.string.regex("^[a-z]+@[a-z]+\\.com$");
+	stringRegexMatchFn = [](const std::string& regex, const std::string& value, std::vector<std::string>& matches)
+	{
+		std::smatch match;
+		if (!std::regex_match(value, match, std::regex(regex, std::regex::icase))) return false;
+		for (const auto& group : match) matches.push_back(group.str());
+		return true;
+	};
+	CHECK(email.validate("JOHN@EXAMPLE.COM"));
+	std::vector<std::string> matches;
+	CHECK(email.match("JOHN@EXAMPLE.COM", matches));
+	stringRegexMatchFn = [](const std::string&, const std::string&, std::vector<std::string>&) { return true; };
+	CHECK(email.validate(""));
+	CHECK(email.validate("no at sign"));
+	stringRegexMatchFn = previous;
+	CHECK_FALSE(email.validate("JOHN@EXAMPLE.COM"));
+
+	// Replacing only the view hook: validate reaches it without the prefilter, like match does
+	StringRegexViewMatchFn previousView = stringRegexViewMatchFn;
+	size_t captureCount;
+	stringRegexViewMatchFn
+		= [](const std::string& regex, std::string_view value, std::string_view*, size_t, size_t& captureCount)
+	{
+		captureCount = 0;
+		return std::regex_match(value.begin(), value.end(), std::regex(regex, std::regex::icase));
+	};
+	auto lower = v.string.regex("abc");
+	CHECK(lower.validate("ABC"));
+	CHECK(lower.match("ABC", nullptr, 0, captureCount));
+	CHECK_FALSE(lower.validate("ABD"));
+	stringRegexViewMatchFn = previousView;
+	CHECK_FALSE(lower.validate("ABC"));
+
+	stringRegexViewMatchFn = [](const std::string&, std::string_view, std::string_view*, size_t, size_t& captureCount)
+	{
+		captureCount = 0;
+		return true;
+	};
+	CHECK(email.match("x", nullptr, 0, captureCount));
+	stringRegexViewMatchFn = previousView;
+	CHECK_FALSE(email.match("x", nullptr, 0, captureCount));
+}
+
+TEST_CASE("RegexCache")
+{
+	RegexCache cache(2);
+
+	auto digits = cache.get("^[0-9]+$");
+	CHECK(std::regex_match("123", *digits));
+	CHECK(cache.get("^[0-9]+$") == digits);
+	CHECK(cache.get("^[a-z]+$") != digits);
+	// Flags are part of the key
+	CHECK(cache.get("^[0-9]+$", std::regex_constants::ECMAScript | std::regex_constants::icase) != digits);
+
+	auto stats = cache.stats();
+	CHECK(stats.hits == 1);
+	CHECK(stats.misses == 3);
+	CHECK(stats.evictions == 1);
+	CHECK(cache.size() == 2);
+
+	// Least recently used entry was evicted
+	CHECK(cache.get("^[0-9]+$") != digits);
+	CHECK(cache.stats().misses == 4);
+
+	cache.setCapacity(1);
+	CHECK(cache.size() == 1);
+	CHECK_THROWS_AS(cache.get("(unclosed"), std::regex_error);
+
+	cache.clear();
+	CHECK(cache.size() == 0);
+	CHECK(cache.stats().hits == 0);
+}
+
+TEST_CASE("StringRegexValidator - Uses Process-Wide Cache")
+{
+	Validator v;
+	auto validator = v.string.regex("^cached-[0-9]+$");
+
+	CHECK(validator.validate("cached-1"));
+	auto before = regexCache().stats();
+	CHECK(validator.validate("cached-2"));
+	CHECK_FALSE(validator.validate("cached-x"));
+	auto after = regexCache().stats();
+	CHECK(after.hits == before.hits + 2);
+	CHECK(after.misses == before.misses);
+}
+
 TEST_CASE("StringEmailValidator")
 {
 	Validator v;
@@ -322,6 +717,55 @@ TEST_CASE("StringUuidValidator")
 	CHECK_FALSE(errors.empty());
 }
 
+TEST_CASE("StringUuidValidator - Scanner Matches Regex")
+{
+	Validator v;
+	auto validator = v.string.uuid();
+	const std::regex reference(StringUuidValidator::getRegex());
+	const std::vector<std::string> bases = {"123e4567-e89b-12d3-a456-426614174000",
+		"550E8400-E29B-81D4-B716-446655440000",
+		"00000000-0000-1000-8000-000000000000"};
+
+	// Every single-byte substitution of valid UUIDs
+	for (const auto& base : bases)
+	{
+		CHECK(validator.validate(base));
+		for (size_t i = 0; i < base.size(); ++i)
+			for (int c = 0; c < 256; ++c)
+			{
+				std::string value = base;
+				value[i] = static_cast<char>(c);
+				REQUIRE_MESSAGE(validator.validate(value) == std::regex_match(value, reference), value);
+			}
+	}
+
+	// Random insertions, deletions and substitutions
+	std::mt19937 rng(42);
+	const std::string alphabet = "0123456789abcdefABCDEFgG-xz \xC3";
+	for (int n = 0; n < 20000; ++n)
+	{
+		std::string value = bases[rng() % bases.size()];
+		for (int edits = 1 + rng() % 3; edits > 0; --edits)
+		{
+			char c = alphabet[rng() % alphabet.size()];
+			size_t pos = rng() % (value.size() + 1);
+			switch (rng() % 3)
+			{
+			case 0:
+				value.insert(value.begin() + pos, c);
+				break;
+			case 1:
+				if (pos < value.size()) value.erase(pos, 1);
+				break;
+			default:
+				if (pos < value.size()) value[pos] = c;
+				break;
+			}
+		}
+		REQUIRE_MESSAGE(validator.validate(value) == std::regex_match(value, reference), value);
+	}
+}
+
 TEST_CASE("StringUrlValidator")
 {
 	Validator v;
@@ -431,6 +875,64 @@ TEST_CASE("StringTimeValidator")
 	CHECK_FALSE(errors.empty());
 }
 
+TEST_CASE("Date And Time Validators - Calendar")
+{
+	Validator v;
+	auto date = v.string.date();
+	auto local = v.string.dateTime().local();
+	auto global = v.string.dateTime().global(EDateTimeOffset::Optional);
+
+	CHECK_FALSE(date.validate("2023-02-31"));
+	CHECK_FALSE(date.validate("2023-02-29"));
+	CHECK(date.validate("2024-02-29"));	 // Leap year
+	CHECK(date.validate("2000-02-29"));	 // Divisible by 400
+	CHECK_FALSE(date.validate("1900-02-29")); // Divisible by 100
+	CHECK_FALSE(date.validate("2023-04-31"));
+	CHECK(date.validate("2023-12-31"));
+	CHECK_FALSE(date.validate("2023-00-10"));
+	CHECK_FALSE(date.validate("2023-01-00"));
+
+	CHECK_FALSE(local.validate("2023-02-30T10:30"));
+	CHECK(local.validate("2024-02-29T10:30"));
+	CHECK_FALSE(local.validate("2023-12-25T10:30:00.5")); // No fraction in local date time
+
+	CHECK(global.validate("2024-02-29T23:59:59.123456789+14:00"));
+	CHECK_FALSE(global.validate("2023-02-29T10:30:00Z"));
+	CHECK_FALSE(global.validate("2023-12-25T24:00:00Z"));
+	CHECK_FALSE(global.validate("2023-12-25T10:60:00Z"));
+	CHECK_FALSE(global.validate("2023-12-25T10:30:60Z"));
+	CHECK_FALSE(global.validate("2023-12-25T10:30:00.Z"));
+	CHECK_FALSE(global.validate("2023-12-25T10:30:00+05:60"));
+	CHECK_FALSE(global.validate("2023-12-25T10:30:00+0500"));
+	CHECK_FALSE(global.validate("2023-12-25T10:30Z")); // Seconds required
+
+	// Every day number of every month against the standard calendar
+	const std::regex dateReference(StringDateValidator::getRegex());
+	char buffer[16];
+	for (int year : {1900, 2000, 2023, 2024})
+		for (unsigned month = 0; month <= 13; ++month)
+			for (unsigned day = 0; day <= 32; ++day)
+			{
+				std::snprintf(buffer, sizeof(buffer), "%04d-%02u-%02u", year, month, day);
+				const std::chrono::year_month_day ymd{std::chrono::year(year), std::chrono::month(month), std::chrono::day(day)};
+				bool expected = std::regex_match(buffer, dateReference) && ymd.ok();
+				REQUIRE_MESSAGE(date.validate(buffer) == expected, buffer);
+			}
+
+	// Time grammar is unchanged
+	auto time = v.string.time();
+	const std::regex timeReference(StringTimeValidator::getRegex());
+	const std::string alphabet = "0123456789:.Z";
+	std::mt19937 rng(3);
+	for (int n = 0; n < 20000; ++n)
+	{
+		std::string value;
+		for (size_t length = rng() % 14; length > 0; --length) value += alphabet[rng() % alphabet.size()];
+		if (n % 2) value = std::to_string(rng() % 25) + ":" + std::to_string(rng() % 61) + value.substr(0, rng() % 5);
+		REQUIRE_MESSAGE(time.validate(value) == std::regex_match(value, timeReference), value);
+	}
+}
+
 TEST_CASE("StringIpValidator")
 {
 	Validator v;
@@ -466,6 +968,97 @@ TEST_CASE("StringIpValidator")
 	CHECK_FALSE(errors.empty());
 }
 
+TEST_CASE("StringIpValidator - Parsed Address")
+{
+	Validator v;
+	IpAddress address;
+
+	CHECK(v.string.ip(EIpVersion::Ipv4, true).parse("192.168.1.1/24", address));
+	CHECK(address.version == EIpVersion::Ipv4);
+	CHECK(address.bytes[0] == 192);
+	CHECK(address.bytes[1] == 168);
+	CHECK(address.bytes[2] == 1);
+	CHECK(address.bytes[3] == 1);
+	CHECK(address.prefixLength == 24);
+
+	CHECK(v.string.ip(EIpVersion::Ipv6).parse("2001:db8::8a2e:370:7334", address));
+	const std::array<uint8_t, 16> expected = {0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0x8a, 0x2e, 0x03, 0x70, 0x73, 0x34};
+	CHECK(address.bytes == expected);
+	CHECK(address.prefixLength == -1);
+
+	CHECK(v.string.ip(EIpVersion::Ipv6).parse("::1", address));
+	CHECK(address.bytes[15] == 1);
+	CHECK(v.string.ip(EIpVersion::Ipv6).parse("::", address));
+	CHECK(v.string.ip(EIpVersion::Ipv6, true).parse("fe80::/10", address));
+	CHECK(address.bytes[0] == 0xfe);
+	CHECK(address.bytes[1] == 0x80);
+	CHECK(address.prefixLength == 10);
+
+	CHECK_FALSE(v.string.ip(EIpVersion::Ipv4).validate("01.2.3.4"));			// Leading zero
+	CHECK_FALSE(v.string.ip(EIpVersion::Ipv4, true).validate("1.2.3.4/08")); // Leading zero
+	CHECK_FALSE(v.string.ip(EIpVersion::Ipv4, true).validate("1.2.3.4"));	// Missing prefix
+	CHECK_FALSE(v.string.ip(EIpVersion::Ipv4).validate("1.2.3.4/8"));		// Unexpected prefix
+	CHECK_FALSE(v.string.ip(EIpVersion::Ipv6).validate("1::2::3"));
+	CHECK_FALSE(v.string.ip(EIpVersion::Ipv6).validate("1:2:3:4:5:6:7:8::")); // "::" must stand for at least one group
+	CHECK_FALSE(v.string.ip(EIpVersion::Ipv6).validate("12345::"));
+	CHECK_FALSE(v.string.ip(EIpVersion::Ipv6).validate("1:2:3:4:5:6:7:"));
+}
+
+TEST_CASE("StringIpValidator - Parser Matches Regex")
+{
+	Validator v;
+	const std::vector<std::string> bases = {"192.168.1.1",
+		"0.0.0.0/0",
+		"255.255.255.255/32",
+		"10.20.30.40/8",
+		"2001:0db8:85a3:0000:0000:8a2e:0370:7334",
+		"2001:db8::8a2e:370:7334/64",
+		"::1",
+		"::/128",
+		"fe80::"};
+	const std::string alphabet = "0123456789abcdefABCDEFg:./";
+	std::mt19937 rng(7);
+
+	for (EIpVersion version : {EIpVersion::Ipv4, EIpVersion::Ipv6})
+		for (bool withPrefixLength : {false, true})
+		{
+			auto validator = v.string.ip(version, withPrefixLength);
+			const std::regex reference(validator.getPattern());
+			for (int n = 0; n < 20000; ++n)
+			{
+				std::string value = bases[rng() % bases.size()];
+				for (int edits = rng() % 4; edits > 0; --edits)
+				{
+					char c = alphabet[rng() % alphabet.size()];
+					size_t pos = rng() % (value.size() + 1);
+					switch (rng() % 3)
+					{
+					case 0:
+						value.insert(value.begin() + pos, c);
+						break;
+					case 1:
+						if (pos < value.size()) value.erase(pos, 1);
+						break;
+					default:
+						if (pos < value.size()) value[pos] = c;
+						break;
+					}
+				}
+				bool expected = std::regex_match(value, reference);
+				// The regex lets "::" stand for zero groups, e.g. "1:2:3:4:5:6:7:8::"
+				if (expected && value.find("::") != std::string::npos)
+				{
+					std::string address = value.substr(0, value.find('/'));
+					size_t groups = 0;
+					for (size_t i = 0; i < address.size(); ++i)
+						if (address[i] != ':' && (i == 0 || address[i - 1] == ':')) ++groups;
+					expected = groups <= 7;
+				}
+				REQUIRE_MESSAGE(validator.validate(value) == expected, value);
+			}
+		}
+}
+
 TEST_CASE("StringMacValidator")
 {
 	Validator v;
@@ -492,6 +1085,107 @@ TEST_CASE("StringMacValidator")
 	CHECK_FALSE(errors.empty());
 }
 
+TEST_CASE("Format Validators - Compiled Regex")
+{
+	Validator v;
+	auto email = v.string.email();
+	auto emailCopy = email;
+	CHECK(email.compiledRegex == emailCopy.compiledRegex);
+	CHECK(emailCopy.validate("test@example.com"));
+	CHECK_FALSE(emailCopy.validate("notanemail"));
+
+	auto mac = v.string.mac("-");
+	auto macCopy = mac;
+	CHECK(mac.compiledRegex == macCopy.compiledRegex);
+	CHECK(macCopy.validate("00-11-22-33-44-55"));
+
+	// Shared compiled pattern is read concurrently
+	std::vector<std::thread> threads;
+	std::atomic<int> failures{0};
+	for (int t = 0; t < 4; ++t)
+		threads.emplace_back(
+			[&]
+			{
+				for (int i = 0; i < 200; ++i)
+					if (!email.validate("user.name@domain.co.uk") || email.validate("@example.com")) ++failures;
+			});
+	for (auto& thread : threads) thread.join();
+	CHECK(failures == 0);
+}
+
+TEST_CASE("String Validators - string_view Input")
+{
+	Validator v;
+	// Slices of a receive buffer, longer than the small string optimization
+	const std::string buffer = "id=123e4567-e89b-12d3-a456-426614174000;ip=192.168.100.200;date=2024-02-29;"
+							   "note=this note is long enough to need a heap allocation as a std::string";
+	std::string_view uuid = std::string_view(buffer).substr(3, 36);
+	std::string_view ip = std::string_view(buffer).substr(43, 15);
+	std::string_view date = std::string_view(buffer).substr(64, 10);
+	std::string_view note = std::string_view(buffer).substr(80);
+
+	auto uuidValidator = v.string.uuid();
+	auto ipValidator = v.string.ip(EIpVersion::Ipv4);
+	auto dateValidator = v.string.date();
+	auto lengthValidator = v.string.length.between(10, 200);
+	auto startsWithValidator = v.string.startsWith("this note");
+	auto endsWithValidator = v.string.endsWith("std::string");
+	auto includesValidator = v.string.includes("heap");
+	auto compareValidator = v.string.compare.between("a", "z");
+	auto literalValidator = v.string.literals({"192.168.100.200", "10.0.0.1"});
+	auto macValidator = v.string.mac();
+	auto linearRegex = v.string.regex("^this (\\w+) .*$", ERegexEngine::Linear);
+	linearRegex.validate(note); // warm up thread-local buffers
+
+	size_t before = allocationCount;
+	CHECK(uuidValidator.validate(uuid));
+	CHECK(ipValidator.validate(ip));
+	CHECK(dateValidator.validate(date));
+	CHECK(lengthValidator.validate(note));
+	CHECK(startsWithValidator.validate(note));
+	CHECK(endsWithValidator.validate(note));
+	CHECK(includesValidator.validate(note));
+	CHECK(compareValidator.validate(note));
+	CHECK(literalValidator.validate(ip));
+	CHECK(linearRegex.validate(note));
+	CHECK(allocationCount == before);
+
+	// std::regex keeps its own match state, but value itself is still not copied
+	CHECK_FALSE(macValidator.validate(note.substr(0, 17)));
+
+	CHECK(v.string.email().validate(std::string_view("test@example.com")));
+	CHECK(v.string.regex("^[a-z]+$").validate(std::string_view("abc")));
+	std::vector<std::string> errors;
+	CHECK_FALSE(uuidValidator.validate(date, "id", errors));
+	CHECK(errors.size() == 1);
+	CHECK(errors[0].find("2024-02-29") != std::string::npos);
+	CHECK(v.string.length.max(4).crop(note) == "this");
+}
+
+TEST_CASE("ValidatorBuilder - string_view Fields")
+{
+	struct Header
+	{
+		std::string_view name;
+		std::string_view value;
+	};
+
+	Validator v;
+	ValidatorBuilder<Header> builder;
+	builder.add("name", &Header::name, v.string.literals({"Content-Type", "Accept"}));
+	builder.add("value", &Header::value, v.string.length.between(1, 64));
+
+	const std::string raw = "Content-Type: application/json";
+	Header header{std::string_view(raw).substr(0, 12), std::string_view(raw).substr(14)};
+	CHECK(builder.validate(header));
+
+	std::vector<std::string> errors;
+	Header invalid{std::string_view(raw).substr(0, 7), std::string_view()};
+	CHECK_FALSE(builder.validate(invalid, "header", errors));
+	CHECK(errors.size() == 2);
+	CHECK(errors[0].find("header.name") != std::string::npos);
+}
+
 // Integration Tests
 TEST_CASE("Multiple Validators - Error Collection")
 {
@@ -852,6 +1546,317 @@ TEST_CASE("ValidatorBuilder - Nested Object with Stop On Error")
 	CHECK(errors.size() == 1);
 }
 
+// Only reports through the error list
+struct EvenValidator
+{
+	bool validate(const int& value, const std::string& varName, std::vector<std::string>& errors) const
+	{
+		if (value % 2 == 0) return true;
+		errors.push_back(varName + " is odd");
+		return false;
+	}
+};
+
+TEST_CASE("ValidatorBuilder - Predicate Path")
+{
+	Validator v;
+	ValidatorBuilder<Address> addressBuilder;
+	addressBuilder.add("street", &Address::street, v.string.length.min(5));
+	addressBuilder.add("city", &Address::city, v.string.length.min(3));
+
+	ValidatorBuilder<Company> companyBuilder;
+	companyBuilder.add("name", &Company::name, v.string.length.between(1, 100));
+	companyBuilder.add("address", &Company::address, addressBuilder);
+	companyBuilder.add("employeeCount", &Company::employeeCount, EvenValidator());
+
+	AndValidator<int> andValidator;
+	andValidator.add(v.number.greaterThan(0));
+	andValidator.add(EvenValidator());
+	OrValidator<int> orValidator;
+	orValidator.add(v.number.lessThan(0));
+	orValidator.add(andValidator);
+
+	Person owner{35, "John Smith", "john@example.com"};
+	Company valid{"Acme Corp", {"123 Main Street", "New York", "10001"}, owner, 50};
+	Company invalidName{"", {"123 Main Street", "New York", "10001"}, owner, 50};
+	Company invalidCity{"Acme Corp", {"123 Main Street", "NY", "10001"}, owner, 50};
+	Company oddCount{"Acme Corp", {"123 Main Street", "New York", "10001"}, owner, 51};
+
+	// Rejections do not build field names or messages
+	size_t before = allocationCount;
+	CHECK(companyBuilder.validate(valid));
+	CHECK_FALSE(companyBuilder.validate(invalidName));
+	CHECK_FALSE(companyBuilder.validate(invalidCity));
+	CHECK_FALSE(andValidator.validate(-2));
+	CHECK_FALSE(orValidator.validate(0));
+	CHECK(orValidator.validate(-3));
+	CHECK(andValidator.validate(4));
+	CHECK(allocationCount == before);
+
+	// Validators without a predicate overload still decide the result
+	CHECK_FALSE(companyBuilder.validate(oddCount));
+	CHECK_FALSE(andValidator.validate(3));
+	CHECK_FALSE(orValidator.validate(3));
+
+	// Both paths agree
+	for (const Company* company : {&valid, &invalidName, &invalidCity, &oddCount})
+	{
+		std::vector<std::string> errors;
+		CHECK(companyBuilder.validate(*company) == companyBuilder.validate(*company, "company", errors));
+	}
+	std::vector<std::string> errors;
+	CHECK_FALSE(companyBuilder.validate(oddCount, "company", errors));
+	CHECK(errors == std::vector<std::string>{"company.employeeCount is odd"});
+}
+
+TEST_CASE("ValidationError - Structured Records")
+{
+	Validator v;
+	ValidatorBuilder<Company> builder;
+	builder.add("name", &Company::name, v.string.length.between(1, 100));
+	builder.add("employeeCount", &Company::employeeCount, v.number.between(0, 1000));
+	builder.add("employeeCount", &Company::employeeCount, EvenValidator());
+
+	Company company{"", {"123 Main Street", "New York", "10001"}, {35, "John Smith", "john@example.com"}, 1001};
+	std::vector<ValidationError> records;
+	CHECK_FALSE(builder.validate(company, "company", records));
+	REQUIRE(records.size() == 3);
+
+	CHECK(records[0].code == EValidationErrorCode::StringLengthBetween);
+	CHECK(records[0].path == "company.name");
+	CHECK(std::get<std::string>(records[0].received).empty());
+	CHECK(std::get<uint64_t>(records[0].params[0]) == 1);
+	CHECK(std::get<uint64_t>(records[0].params[1]) == 100);
+
+	CHECK(records[1].code == EValidationErrorCode::NumberBetween);
+	CHECK(std::get<int64_t>(records[1].received) == 1001);
+	CHECK(records[1].params.size() == 4);
+
+	CHECK(records[2].code == EValidationErrorCode::Custom);
+	CHECK(records[2].message() == "company.employeeCount is odd");
+
+	// Formatting a record gives the same message as the string API
+	std::vector<std::string> messages;
+	CHECK_FALSE(builder.validate(company, "company", messages));
+	REQUIRE(messages.size() == records.size());
+	for (size_t i = 0; i < records.size(); ++i) CHECK(records[i].message() == messages[i]);
+	CHECK(messages[1] == "ValidationError: 'company.employeeCount' received 1001, expected 0 <= {value} <= 1000.");
+
+	// OrValidator reports the failures of every alternative
+	OrValidator<std::string> orValidator;
+	orValidator.add(v.string.uuid());
+	orValidator.add(v.string.ip(EIpVersion::Ipv6, true));
+	records.clear();
+	CHECK_FALSE(orValidator.validate("abc", "id", records));
+	REQUIRE(records.size() == 2);
+	CHECK(records[0].code == EValidationErrorCode::StringUuid);
+	CHECK(records[1].code == EValidationErrorCode::StringIp);
+	CHECK(records[1].message()
+		  == "ValidationError: 'id' received \"abc\", expected to be a valid IPv6 address with prefix length.");
+	CHECK(orValidator.validate("::1/128", "id", records));
+	CHECK(records.size() == 2);
+}
+
+TEST_CASE("ErrorSink")
+{
+	Validator v;
+	ValidatorBuilder<Person> builder;
+	builder.add("age", &Person::age, v.number.between(0, 120));
+	builder.add("name", &Person::name, v.string.length.between(1, 50));
+	builder.add("email", &Person::email, v.string.email());
+
+	Person valid{25, "John Doe", "john@example.com"};
+	Person invalid{150, "", "not-an-email"};
+	Person invalidAge{-1, "John \"JD\" Doe", "john@example.com"};
+
+	SUBCASE("Counting")
+	{
+		CountingErrorSink sink;
+		CHECK_FALSE(builder.validate(invalid, "person", sink));
+		CHECK_FALSE(builder.validate(invalidAge, "person", sink));
+		// the result covers the current call only
+		CHECK(builder.validate(valid, "person", sink));
+		CHECK(sink.size() == 4);
+		CHECK(sink.count(EValidationErrorCode::NumberBetween) == 2);
+		CHECK(sink.count(EValidationErrorCode::StringLengthBetween) == 1);
+		CHECK(sink.count(EValidationErrorCode::StringEmail) == 1);
+		CHECK(sink.count(EValidationErrorCode::StringUuid) == 0);
+	}
+
+	SUBCASE("First N")
+	{
+		FirstErrorsSink sink(2);
+		CHECK_FALSE(builder.validate(invalid, "person", sink));
+		CHECK_FALSE(builder.validate(invalidAge, "person", sink));
+		CHECK(sink.size() == 4);
+		REQUIRE(sink.errors.size() == 2);
+		CHECK(sink.errors[0].path == "person.age");
+		CHECK(sink.errors[1].path == "person.name");
+	}
+
+	SUBCASE("JSON Lines")
+	{
+		std::ostringstream out;
+		JsonLinesErrorSink sink(out);
+		CHECK_FALSE(builder.validate(invalidAge, "person", sink));
+		CHECK(out.str() == "{\"code\":\"NumberBetween\",\"path\":\"person.age\",\"received\":-1,\"params\":[0,120,1,1]}\n");
+
+		std::ostringstream withMessage;
+		JsonLinesErrorSink messageSink(withMessage, true);
+		v.string.startsWith("\"").validate(invalidAge.name, "name\t", messageSink);
+		CHECK(withMessage.str()
+			  == "{\"code\":\"StringStartsWith\",\"path\":\"name\\t\",\"received\":\"John \\\"JD\\\" Doe\",\"params\":[\"\\\"\"],"
+				 "\"message\":\"ValidationError: 'name\\t' received \\\"John \\\"JD\\\" Doe\\\", "
+				 "expected to start with \\\"\\\"\\\".\"}\n");
+	}
+
+	SUBCASE("Vector")
+	{
+		std::vector<std::string> direct;
+		std::vector<std::string> messages;
+		VectorErrorSink sink(messages);
+		CHECK_FALSE(builder.validate(invalid, "person", direct));
+		CHECK_FALSE(builder.validate(invalid, "person", sink));
+		CHECK(messages == direct);
+		CHECK(sink.size() == 3);
+	}
+}
+
+struct Catalog
+{
+	std::string name;
+	Product featured;
+	std::vector<int> ids;
+};
+
+TEST_CASE("TextFormat - Matches std::ostream")
+{
+	auto format = [](auto value)
+	{
+		std::string out;
+		TextFormat::appendNumber(out, value);
+		return out;
+	};
+	auto stream = [](auto value)
+	{
+		std::ostringstream out;
+		out << value;
+		return out.str();
+	};
+
+	const double inf = std::numeric_limits<double>::infinity();
+	const double edgeValues[] = {0.0, -0.0, 1.0, -1.5, 0.1, 1e-5, 123456.0, 1234567.0, 999999.5, 1e20, 2.0 / 3, 5e-324,
+		1.7976931348623157e308, inf, -inf};
+	for (double value : edgeValues)
+		CHECK(format(value) == stream(value));
+	for (int64_t value : {int64_t(0), int64_t(-1), std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()})
+		CHECK(format(value) == stream(value));
+	CHECK(format(std::numeric_limits<uint64_t>::max()) == stream(std::numeric_limits<uint64_t>::max()));
+
+	std::mt19937_64 rng(7);
+	for (int i = 0; i < 20000; ++i)
+	{
+		uint64_t bits = rng();
+		double value;
+		std::memcpy(&value, &bits, sizeof(value));
+		if (std::isnan(value)) continue;
+		const double mantissa = static_cast<double>(rng() % 2000000) - 1000000.0;
+		float single = static_cast<float>(std::ldexp(mantissa, static_cast<int>(rng() % 80) - 40));
+		CHECK(format(value) == stream(value));
+		CHECK(format(static_cast<double>(single)) == stream(single));
+	}
+}
+
+TEST_CASE("FieldPath")
+{
+	CHECK(FieldPath("person").str() == "person");
+	FieldPath root("");
+	FieldPath owners(root, "owners");
+	FieldPath second(owners, size_t(2));
+	CHECK(FieldPath(second, "name").str() == ".owners[2].name");
+
+	Validator v;
+	ValidatorBuilder<Product> productBuilder;
+	productBuilder.add("price", &Product::price, v.number.greaterThan(0.0));
+	productBuilder.addVector("tags", &Product::tags, v.number.between(1, 100));
+	ValidatorBuilder<Catalog> catalogBuilder;
+	catalogBuilder.add("name", &Catalog::name, v.string.length.min(1));
+	catalogBuilder.add("featured", &Catalog::featured, productBuilder);
+	catalogBuilder.addVector("ids", &Catalog::ids, v.number.greaterThan(0));
+
+	Catalog catalog{"", {1, -5.0, "Widget", {50, 0, 101}, {}}, {1, -2, 3}};
+	std::vector<std::string> errors;
+	CHECK_FALSE(catalogBuilder.validate(catalog, "catalog", errors));
+	REQUIRE(errors.size() == 5);
+	CHECK(errors[0].find("'catalog.name'") != std::string::npos);
+	CHECK(errors[1].find("'catalog.featured.price'") != std::string::npos);
+	CHECK(errors[2].find("'catalog.featured.tags[1]'") != std::string::npos);
+	CHECK(errors[3].find("'catalog.featured.tags[2]'") != std::string::npos);
+	CHECK(errors[4].find("'catalog.ids[1]'") != std::string::npos);
+
+	// No path is rendered when the sink does not need records
+	CountingErrorSink sink;
+	const std::string name = "a catalog name that is longer than any small string buffer";
+	size_t before = allocationCount;
+	CHECK_FALSE(catalogBuilder.validate(catalog, name, sink));
+	CHECK(allocationCount == before);
+	CHECK(sink.size() == 5);
+
+	std::vector<ValidationError> records;
+	CHECK_FALSE(catalogBuilder.validate(catalog, name, records));
+	CHECK(records[3].path == name + ".featured.tags[2]");
+}
+
+TEST_CASE("Schema - Matches ValidatorBuilder")
+{
+	Validator v;
+	auto productSchema = makeSchema<Product>(v.field("price", &Product::price, v.number.greaterThan(0.0)),
+		v.vectorField("tags", &Product::tags, v.number.between(1, 100)),
+		v.vectorField("categories", &Product::categories, v.string.length.min(3)));
+	auto catalogSchema = makeSchema<Catalog>(v.field("name", &Catalog::name, v.string.length.min(1)),
+		v.field("featured", &Catalog::featured, productSchema), v.vectorField("ids", &Catalog::ids, EvenValidator()));
+
+	ValidatorBuilder<Product> productBuilder;
+	productBuilder.add("price", &Product::price, v.number.greaterThan(0.0));
+	productBuilder.addVector("tags", &Product::tags, v.number.between(1, 100));
+	productBuilder.addVector("categories", &Product::categories, v.string.length.min(3));
+	ValidatorBuilder<Catalog> catalogBuilder;
+	catalogBuilder.add("name", &Catalog::name, v.string.length.min(1));
+	catalogBuilder.add("featured", &Catalog::featured, productBuilder);
+	catalogBuilder.addVector("ids", &Catalog::ids, EvenValidator());
+
+	const std::vector<Catalog> catalogs = {
+		{"Tools", {1, 9.5, "Hammer", {1, 2}, {"hardware"}}, {2, 4}},
+		{"", {1, -1.0, "Hammer", {0, 50, 101}, {"hw", "tools"}}, {1, 2, 3}},
+		{"Tools", {1, 9.5, "Hammer", {1, 2}, {"hardware"}}, {2, 5}},
+		{"Tools", {1, 9.5, "Hammer", {}, {"x"}}, {}},
+	};
+	for (const auto& catalog : catalogs)
+	{
+		CHECK(catalogSchema.validate(catalog) == catalogBuilder.validate(catalog));
+		for (bool bStopOnError : {false, true})
+		{
+			std::vector<std::string> schemaErrors;
+			std::vector<std::string> builderErrors;
+			CHECK(catalogSchema.validate(catalog, "catalog", schemaErrors, bStopOnError)
+				  == catalogBuilder.validate(catalog, "catalog", builderErrors, bStopOnError));
+			CHECK(schemaErrors == builderErrors);
+		}
+	}
+
+	std::vector<std::string> errors;
+	CHECK_FALSE(catalogSchema.validate(catalogs[1], "catalog", errors));
+	CHECK(errors.size() == 7);
+	CHECK(errors[1].find("'catalog.featured.price'") != std::string::npos);
+	CHECK(errors[6] == "catalog.ids[2] is odd");
+
+	// A schema can be used wherever a validator is expected
+	ValidatorBuilder<Catalog> wrapper;
+	wrapper.add("featured", &Catalog::featured, productSchema);
+	CHECK(wrapper.validate(catalogs[0]));
+	CHECK_FALSE(wrapper.validate(catalogs[1]));
+}
+
 // String ContainsAnyChar Validator Tests
 TEST_CASE("StringContainsAnyCharValidator")
 {
@@ -1257,4 +2262,684 @@ TEST_CASE("OrValidator - Complex Combination")
 	CHECK(orValidator.validate(2000));		// Greater than 1000
 	CHECK_FALSE(orValidator.validate(50));	// Not in any condition
 	CHECK_FALSE(orValidator.validate(500)); // Not in any condition
+}
+
+// Unrelated class with a validate member and a bool conversion: the validator operators must not apply
+struct Form
+{
+	bool bValid;
+	bool validate() const { return bValid; }
+	explicit operator bool() const { return bValid; }
+};
+
+struct MultipleOfFourValidator
+{
+	bool validate(const int& value, const std::string& varName, std::vector<std::string>& errors) const
+	{
+		if (value % 4 == 0) return true;
+		errors.push_back(varName + " is not a multiple of 4");
+		return false;
+	}
+};
+
+template <> struct is_validator<MultipleOfFourValidator> : std::true_type
+{
+};
+
+TEST_CASE("Validator Expressions")
+{
+	static_assert(is_validator<NumberBetweenValidator<int>>::value);
+	static_assert(is_validator<ValidatorBuilder<Person>>::value);
+	static_assert(is_validator<NotExpression<NumberBetweenValidator<int>>>::value);
+	static_assert(!is_validator<int>::value);
+	static_assert(!is_validator<std::string>::value);
+	static_assert(!is_validator<Form>::value);
+
+	Form valid{true};
+	Form invalid{false};
+	CHECK_FALSE(static_cast<bool>(valid && invalid));
+	CHECK(static_cast<bool>(valid || invalid));
+	CHECK(static_cast<bool>(!invalid));
+
+	auto quarterPercent = MultipleOfFourValidator() && Validator().number.between(0, 100);
+	CHECK(quarterPercent.validate(44));
+	CHECK_FALSE(quarterPercent.validate(42));
+	CHECK_FALSE(quarterPercent.validate(104));
+
+	Validator v;
+	auto roundPercent = v.number.between(0, 100) && v.number.multipleOf(5);
+	CHECK(roundPercent.validate(25));
+	CHECK_FALSE(roundPercent.validate(26));
+	CHECK_FALSE(roundPercent.validate(105));
+
+	auto outside = !v.number.between(10, 20);
+	CHECK(outside.validate(5));
+	CHECK_FALSE(outside.validate(15));
+
+	auto identifier = (v.string.uuid() || v.string.startsWith("id-")) && !v.string.includes(" ");
+	CHECK(identifier.validate("123e4567-e89b-12d3-a456-426614174000"));
+	CHECK(identifier.validate(std::string("id-42")));
+	CHECK_FALSE(identifier.validate("id- 42"));
+	CHECK_FALSE(identifier.validate("42"));
+
+	std::vector<std::string> errors;
+	CHECK_FALSE(roundPercent.validate(107, "percent", errors));
+	REQUIRE(errors.size() == 2);
+	CHECK(errors[0] == "ValidationError: 'percent' received 107, expected 0 <= {value} <= 100.");
+	CHECK(errors[1] == "ValidationError: 'percent' received 107, expected multiple of 5.");
+	errors.clear();
+	CHECK_FALSE(roundPercent.validate(107, "percent", errors, true));
+	CHECK(errors.size() == 1);
+
+	errors.clear();
+	CHECK(identifier.validate("id-1", "id", errors));
+	CHECK_FALSE(identifier.validate("x y", "id", errors));
+	REQUIRE(errors.size() == 3);
+	CHECK(errors[1].find("expected to start with \"id-\"") != std::string::npos);
+	CHECK(errors[2] == "ValidationError: 'id' received \"x y\", expected the negated validator to fail.");
+
+	std::vector<ValidationError> records;
+	CHECK_FALSE(outside.validate(15, "x", records));
+	REQUIRE(records.size() == 1);
+	CHECK(records[0].code == EValidationErrorCode::Not);
+
+	// Expressions work wherever a validator is expected, objects are not recorded as values
+	ValidatorBuilder<Person> builder;
+	builder.add("age", &Person::age, v.number.between(0, 120) && !v.number.literals<int>({13}));
+	CHECK(builder.validate(Person{30, "John", "john@example.com"}));
+	CHECK_FALSE(builder.validate(Person{13, "John", "john@example.com"}));
+
+	auto notBuilder = !builder;
+	errors.clear();
+	CHECK_FALSE(notBuilder.validate(Person{30, "John", "john@example.com"}, "person", errors));
+	CHECK(errors[0] == "ValidationError: 'person' expected the negated validator to fail.");
+}
+
+TEST_CASE("AnyValidator")
+{
+	Validator v;
+	// e.g. rules loaded from configuration
+	std::vector<AnyValidator<int>> rules;
+	rules.emplace_back(v.number.between(0, 100));
+	rules.emplace_back(v.number.multipleOf(5));
+	rules.emplace_back(v.number.literals<int>({5, 10, 15, 20, 25, 30, 35, 40}));
+	rules.emplace_back(v.number.greaterThan(0) && !v.number.between(40, 50));
+	CHECK(rules[0].isInline());
+	CHECK(rules[3].isInline());
+
+	auto passesAll = [&](int value)
+	{
+		for (const auto& rule : rules)
+			if (!rule.validate(value)) return false;
+		return true;
+	};
+	CHECK(passesAll(25));
+	CHECK_FALSE(passesAll(40));
+	CHECK_FALSE(passesAll(26));
+
+	std::vector<std::string> errors;
+	CHECK_FALSE(rules[1].validate(26, "x", errors));
+	CHECK(errors == std::vector<std::string>{"ValidationError: 'x' received 26, expected multiple of 5."});
+
+	// Large validators are shared between copies, small ones are copied in place
+	AnyValidator<std::string> uuid = v.string.uuid();
+	AnyValidator<std::string> regex = v.string.regex("^[a-z]+$");
+	CHECK_FALSE(regex.isInline());
+	CHECK(AnyValidator<std::string>(v.string.startsWith("id-")).isInline());
+	// Data that lookups are built from is only readable, so it cannot drift from them
+	auto currencies = v.string.literals({"USD", "EUR", "JPY", "GBP", "CHF", "CAD"});
+	CHECK(currencies.getLiterals().size() == 6);
+	CHECK(std::is_nothrow_move_constructible_v<StringLiteralValidator>);
+	CHECK(std::is_nothrow_move_constructible_v<StringRegexValidator>);
+	CHECK(std::is_nothrow_move_constructible_v<NumberLiteralValidator<int>>);
+	CHECK(v.string.regex("^[a-z]+$").getPattern() == "^[a-z]+$");
+	CHECK(v.string.mac("-").getSeparator() == "-");
+	// what ValidatorBuilder::add stores for a field
+	AnyValidator<Person> ageField(
+		SchemaField<Person, int, NumberBetweenValidator<int>>("age", &Person::age, v.number.between(0, 120)));
+	AnyValidator<Person> nameField(
+		SchemaField<Person, std::string, StringLengthBetweenValidator>("name", &Person::name, v.string.length.between(1, 50)));
+	CHECK(ageField.isInline());
+	CHECK(nameField.isInline());
+	CHECK_FALSE(ageField.validate(Person{130, "John", "john@example.com"}));
+	CHECK(nameField.validate(Person{130, "John", "john@example.com"}));
+	size_t before = allocationCount;
+	AnyValidator<int> smallCopy = rules[0];
+	AnyValidator<std::string> largeCopy = regex;
+	AnyValidator<std::string> moved = std::move(largeCopy);
+	CHECK(allocationCount == before);
+	CHECK(smallCopy.validate(50));
+	CHECK(moved.validate("abc"));
+	CHECK_FALSE(moved.validate("ABC"));
+
+	moved = uuid;
+	CHECK(moved.validate("123e4567-e89b-12d3-a456-426614174000"));
+	moved = regex;
+	CHECK(moved.validate("abc"));
+	smallCopy = rules[1];
+	CHECK_FALSE(smallCopy.validate(7));
+
+	// Composite validators receive bStopOnError
+	ValidatorBuilder<Address> address;
+	address.add("street", &Address::street, v.string.length.min(5));
+	address.add("city", &Address::city, v.string.length.min(3));
+	AnyValidator<Address> any = address;
+	errors.clear();
+	CHECK_FALSE(any.validate(Address{"1", "X", "10001"}, "address", errors, true));
+	CHECK(errors.size() == 1);
+	errors.clear();
+	CHECK_FALSE(any.validate(Address{"1", "X", "10001"}, "address", errors));
+	CHECK(errors.size() == 2);
+}
+
+TEST_CASE("AndValidator / OrValidator - Normalization")
+{
+	Validator v;
+	// Reports like the validators run one by one, whatever was merged
+	auto expectSameAsChildren = [](const auto& combined, const auto& children, const auto& value, bool bAnd)
+	{
+		std::vector<std::string> expected;
+		bool result = bAnd;
+		for (const auto& child : children)
+		{
+			bool passed = child.validate(value);
+			result = bAnd ? result && passed : result || passed;
+		}
+		if (!result)
+			for (const auto& child : children) child.validate(value, "x", expected);
+		std::vector<std::string> errors;
+		CHECK(combined.validate(value) == result);
+		CHECK(combined.validate(value, "x", errors) == result);
+		CHECK(errors == expected);
+	};
+
+	SUBCASE("Numeric bounds")
+	{
+		std::vector<AnyValidator<int>> children = {
+			v.number.greaterThan(0), v.number.lessThan(100), v.number.multipleOf(5), v.number.between(10, 60, false, true)};
+		AndValidator<int> inner;
+		inner.add(v.number.lessThan(100));
+		inner.add(v.number.multipleOf(5));
+		AndValidator<int> andValidator;
+		andValidator.add(v.number.greaterThan(0));
+		andValidator.add(inner);
+		andValidator.add(v.number.between(10, 60, false, true));
+		for (int value = -20; value <= 120; ++value) expectSameAsChildren(andValidator, children, value, true);
+
+		AndValidator<int> fromExpression;
+		fromExpression.add(v.number.greaterThan(0) && v.number.lessThan(100) && v.number.multipleOf(5));
+		fromExpression.add(v.number.between(10, 60, false, true));
+		for (int value = -20; value <= 120; ++value) expectSameAsChildren(fromExpression, children, value, true);
+
+		// Stops at the first failing validator in the order added
+		std::vector<std::string> errors;
+		CHECK_FALSE(andValidator.validate(-5, "x", errors, true));
+		CHECK(errors == std::vector<std::string>{"ValidationError: 'x' received -5, expected value greater than 0."});
+
+		AndValidator<int> limits;
+		limits.add(v.number.greaterThan(std::numeric_limits<int>::max()));
+		CHECK_FALSE(limits.validate(std::numeric_limits<int>::max()));
+	}
+
+	SUBCASE("Floating point bounds")
+	{
+		const double nan = std::numeric_limits<double>::quiet_NaN();
+		const double inf = std::numeric_limits<double>::infinity();
+		std::vector<AnyValidator<double>> children
+			= {v.number.greaterThan(0.0), v.number.greaterOrEqual(0.5), v.number.lessOrEqual(nan)};
+		AndValidator<double> andValidator;
+		for (const auto& child : children) andValidator.add(child);
+		AndValidator<double> lower;
+		lower.add(v.number.greaterThan(0.0));
+		lower.add(v.number.greaterOrEqual(0.5));
+		for (double value : {-1.0, 0.0, 0.25, 0.5, 1.0, inf, -inf, nan})
+		{
+			expectSameAsChildren(andValidator, children, value, true);
+			CHECK(lower.validate(value) == (value >= 0.5));
+		}
+	}
+
+	SUBCASE("String literals and lengths")
+	{
+		std::vector<AnyValidator<std::string>> children = {v.string.length.min(2), v.string.literals({"a", "bb", "ccc", "dddd"}),
+			v.string.literals({"bb", "dddd", "ccc", "e"}), v.string.length.max(3)};
+		AndValidator<std::string> andValidator;
+		for (const auto& child : children) andValidator.add(child);
+		for (std::string value : {"", "a", "bb", "ccc", "dddd", "e", "zz"})
+			expectSameAsChildren(andValidator, children, value, true);
+
+		std::vector<AnyValidator<std::string>> alternatives = {
+			v.string.literals({"USD", "EUR"}), v.string.startsWith("X"), v.string.literals({"JPY", "EUR"})};
+		OrValidator<std::string> inner;
+		inner.add(v.string.startsWith("X"));
+		inner.add(v.string.literals({"JPY", "EUR"}));
+		OrValidator<std::string> orValidator;
+		orValidator.add(v.string.literals({"USD", "EUR"}));
+		orValidator.add(inner);
+		for (std::string value : {"USD", "EUR", "JPY", "XAU", "GBP", ""})
+			expectSameAsChildren(orValidator, alternatives, value, false);
+
+		OrValidator<std::string> fromExpression;
+		fromExpression.add(v.string.literals({"USD", "EUR"}) || v.string.startsWith("X") || v.string.literals({"JPY", "EUR"}));
+		for (std::string value : {"USD", "EUR", "JPY", "XAU", "GBP", ""})
+			expectSameAsChildren(fromExpression, alternatives, value, false);
+	}
+}
+
+TEST_CASE("AndValidator / OrValidator - Adaptive Order")
+{
+	Validator v;
+	const std::string longWord = "b" + std::string(300, 'x');
+
+	// The regex rejects nothing and is slow, the prefix check is cheap and rejects most values
+	AndValidator<std::string> andValidator;
+	andValidator.add(v.string.regex("^[a-z]+$"));
+	andValidator.add(v.string.startsWith("a"));
+	CHECK(andValidator.predicateOrder() == std::vector<size_t>{0, 1});
+	andValidator.enableAdaptiveOrder(4);
+	for (int i = 0; i < 2000; ++i) CHECK_FALSE(andValidator.validate(longWord));
+	CHECK(andValidator.predicateOrder() == std::vector<size_t>{1, 0});
+	CHECK(andValidator.validate("a" + longWord));
+
+	// The reporting path keeps the order the validators were added in
+	std::vector<std::string> errors;
+	CHECK_FALSE(andValidator.validate("B", "x", errors));
+	REQUIRE(errors.size() == 2);
+	CHECK(errors[0].find("regex") != std::string::npos);
+	CHECK(errors[1].find("to start with") != std::string::npos);
+
+	// Copies share the order, adding a validator starts over
+	AndValidator<std::string> copy = andValidator;
+	CHECK(copy.predicateOrder() == std::vector<size_t>{1, 0});
+	copy.add(v.string.endsWith("x"));
+	CHECK(copy.predicateOrder() == std::vector<size_t>{0, 1, 2});
+	CHECK(andValidator.predicateOrder() == std::vector<size_t>{1, 0});
+
+	// Or stops at the first passing check: the cheap check that passes most values moves to the front
+	OrValidator<std::string> orValidator;
+	orValidator.add(v.string.regex("^[0-9]+$"));
+	orValidator.add(v.string.startsWith("b"));
+	orValidator.enableAdaptiveOrder(4);
+	for (int i = 0; i < 2000; ++i) CHECK(orValidator.validate(longWord));
+	CHECK(orValidator.predicateOrder() == std::vector<size_t>{1, 0});
+	CHECK(orValidator.validate("123"));
+	CHECK_FALSE(orValidator.validate("abc"));
+
+	// Sampling is drawn at random per thread: two validators called in turn both get sampled
+	AndValidator<std::string> first;
+	AndValidator<std::string> second;
+	for (auto* validator : {&first, &second})
+	{
+		validator->add(v.string.regex("^[a-z]+$"));
+		validator->add(v.string.startsWith("a"));
+		validator->enableAdaptiveOrder(2);
+	}
+	for (int i = 0; i < 2000; ++i)
+	{
+		CHECK_FALSE(first.validate(longWord));
+		CHECK_FALSE(second.validate(longWord));
+	}
+	CHECK(first.predicateOrder() == std::vector<size_t>{1, 0});
+	CHECK(second.predicateOrder() == std::vector<size_t>{1, 0});
+
+	// Results stay correct while threads sample and reorder concurrently
+	AndValidator<int> numbers;
+	numbers.add(v.number.multipleOf(3));
+	numbers.add(v.number.multipleOf(5));
+	numbers.add(v.number.literals<int>({0, 15, 30, 45, 60, 75, 90, 7}));
+	numbers.enableAdaptiveOrder(2);
+	std::atomic<int> wrong{0};
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t)
+		threads.emplace_back(
+			[&]
+			{
+				for (int i = 0; i < 20000; ++i)
+					if (numbers.validate(i % 100) != (i % 100 % 15 == 0)) ++wrong;
+			});
+	for (auto& thread : threads) thread.join();
+	CHECK(wrong == 0);
+}
+
+template <typename T> static std::vector<T> batchTestValues()
+{
+	std::mt19937 random(42);
+	std::vector<T> values;
+	const T edges[] = {std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max(), T(0), T(1), T(10), T(99), T(100), T(101)};
+	for (size_t i = 0; i < 1003; ++i)
+	{
+		if (i % 7 == 0)
+			values.push_back(edges[(i / 7) % std::size(edges)]);
+		else if constexpr (std::is_floating_point_v<T>)
+			values.push_back(static_cast<T>(std::uniform_real_distribution<double>(-50.0, 150.0)(random)));
+		else
+			values.push_back(static_cast<T>(random() % 200) - (std::is_signed_v<T> ? T(50) : T(0)));
+	}
+	if constexpr (std::is_floating_point_v<T>)
+	{
+		values[3] = std::numeric_limits<T>::quiet_NaN();
+		values[64] = std::numeric_limits<T>::infinity();
+		values[65] = -std::numeric_limits<T>::infinity();
+	}
+	return values;
+}
+
+template <typename T, typename V> static void checkBatch(const V& validator, const std::vector<T>& values)
+{
+	for (size_t size : {size_t(0), size_t(5), size_t(64), size_t(65), values.size()})
+	{
+		std::span<const T> span(values.data(), size);
+		BatchResult result = validator.validateBatch(span);
+		size_t failures = 0;
+		bool bSame = true;
+		for (size_t i = 0; i < size; ++i)
+		{
+			failures += !validator.validate(values[i]);
+			bSame = bSame && result.isValid(i) == validator.validate(values[i]);
+		}
+		CHECK(bSame);
+		CHECK(result.failures == failures);
+		CHECK(result.passed.size() == (size + 63) / 64);
+	}
+}
+
+template <typename T> static void checkNumberBatches()
+{
+	Validator v;
+	const std::vector<T> values = batchTestValues<T>();
+	checkBatch(v.number.between(T(10), T(100)), values);
+	checkBatch(v.number.between(T(10), T(100), false, false), values);
+	checkBatch(v.number.greaterThan(T(10)), values);
+	checkBatch(v.number.greaterOrEqual(T(10)), values);
+	checkBatch(v.number.lessThan(T(100)), values);
+	checkBatch(v.number.lessOrEqual(T(100)), values);
+	checkBatch(v.number.greaterThan(std::numeric_limits<T>::max()), values);
+	checkBatch(v.number.lessOrEqual(std::numeric_limits<T>::lowest()), values);
+	checkBatch(v.number.literals<T>({T(0), T(1), T(99)}), values);
+	if constexpr (std::is_integral_v<T>) checkBatch(v.number.multipleOf(T(3)), values);
+}
+
+TEST_CASE("Number Validators - validateBatch")
+{
+	checkNumberBatches<int32_t>();
+	checkNumberBatches<uint32_t>();
+	checkNumberBatches<int64_t>();
+	checkNumberBatches<uint64_t>();
+	checkNumberBatches<int16_t>();
+	checkNumberBatches<float>();
+	checkNumberBatches<double>();
+
+	// Caller-owned words are reused between calls
+	Validator v;
+	std::vector<float> column = {1.0f, 2.0f, 250.0f, -1.0f};
+	std::vector<uint64_t> passed(1, ~uint64_t(0));
+	CHECK(v.number.between(0.0f, 100.0f).validateBatch(column, passed) == 2);
+	CHECK(passed[0] == 0b0011);
+	std::vector<uint64_t> empty;
+	CHECK_THROWS_AS(v.number.between(0.0f, 100.0f).validateBatch(column, empty), std::length_error);
+}
+
+template <typename T, typename V> static void checkClamp(const V& validator, const std::vector<T>& values)
+{
+	std::vector<T> out(values.size());
+	validator.clamp(values, out);
+	std::vector<T> inPlace = values;
+	validator.clamp(inPlace);
+	bool bSame = true;
+	bool bValid = true;
+	for (size_t i = 0; i < values.size(); ++i)
+	{
+		const T expected = validator.clamp(values[i]);
+		if constexpr (std::is_floating_point_v<T>)
+			if (std::isnan(values[i]))
+			{
+				bSame = bSame && std::isnan(out[i]) && std::isnan(inPlace[i]);
+				continue;
+			}
+		bSame = bSame && out[i] == expected && inPlace[i] == expected;
+		bValid = bValid && validator.validate(expected);
+	}
+	CHECK(bSame);
+	CHECK(bValid);
+}
+
+template <typename T> static void checkNumberClamps()
+{
+	Validator v;
+	const std::vector<T> values = batchTestValues<T>();
+	checkClamp(v.number.between(T(10), T(100)), values);
+	checkClamp(v.number.between(T(10), T(100), false, false), values);
+	checkClamp(v.number.greaterThan(T(10)), values);
+	checkClamp(v.number.greaterOrEqual(T(10)), values);
+	checkClamp(v.number.lessThan(T(100)), values);
+	checkClamp(v.number.lessOrEqual(T(100)), values);
+}
+
+TEST_CASE("Number Validators - Bulk clamp")
+{
+	checkNumberClamps<int32_t>();
+	checkNumberClamps<uint32_t>();
+	checkNumberClamps<int64_t>();
+	checkNumberClamps<uint64_t>();
+	checkNumberClamps<int16_t>();
+	checkNumberClamps<float>();
+	checkNumberClamps<double>();
+
+	// Exclusive bounds clamp to the nearest representable value inside the range
+	Validator v;
+	auto unit = v.number.between(0.0, 1.0, false, false);
+	CHECK(unit.clamp(-3.0) == std::nextafter(0.0, 1.0));
+	CHECK(unit.clamp(0.0) == std::nextafter(0.0, 1.0));
+	CHECK(unit.clamp(7.0) == std::nextafter(1.0, 0.0));
+	CHECK(unit.validate(unit.clamp(-3.0)));
+	CHECK(v.number.greaterThan(0.5f).clamp(0.5f) == std::nextafter(0.5f, 1.0f));
+	CHECK(v.number.lessThan(0.5f).clamp(2.0f) == std::nextafter(0.5f, 0.0f));
+	CHECK(v.number.between(18, 65, false, false).clamp(18) == 19);
+	CHECK(v.number.greaterThan(std::numeric_limits<int>::max()).clamp(0) == std::numeric_limits<int>::max());
+
+	std::vector<float> frame = {-1.0f, 0.5f, 2.0f};
+	std::vector<float> small(2);
+	CHECK_THROWS_AS(v.number.between(0.0f, 1.0f).clamp(frame, small), std::length_error);
+}
+
+template <typename T> static void checkMultipleOf()
+{
+	Validator v;
+	std::mt19937_64 random(7);
+	std::vector<T> values = batchTestValues<T>();
+	for (int i = 0; i < 2000; ++i) values.push_back(static_cast<T>(random()));
+	std::vector<T> divisors = {T(1), T(2), T(3), T(5), T(7), T(8), T(12), T(96), T(1000), std::numeric_limits<T>::max()};
+	if constexpr (std::is_signed_v<T>) divisors.insert(divisors.end(), {T(-1), T(-6), T(-64), std::numeric_limits<T>::lowest()});
+	for (T divisor : divisors)
+	{
+		auto validator = v.number.multipleOf(divisor);
+		bool bSame = true;
+		for (T value : values)
+		{
+			// lowest() % -1 overflows
+			const bool expected = (std::is_signed_v<T> && divisor == static_cast<T>(-1)) || value % divisor == 0;
+			bSame = bSame && validator.validate(value) == expected;
+		}
+		CHECK(bSame);
+		checkBatch(validator, values);
+	}
+	auto zero = v.number.multipleOf(T(0));
+	CHECK(zero.validate(T(0)));
+	CHECK_FALSE(zero.validate(T(3)));
+	checkBatch(zero, values);
+}
+
+TEST_CASE("NumberMultipleOfValidator - Precomputed Divisor")
+{
+	checkMultipleOf<int16_t>();
+	checkMultipleOf<int32_t>();
+	checkMultipleOf<uint32_t>();
+	checkMultipleOf<int64_t>();
+	checkMultipleOf<uint64_t>();
+}
+
+TEST_CASE("NumberMultipleOfValidator - Floating Point")
+{
+	Validator v;
+	auto cents = v.number.multipleOf(0.01);
+	CHECK(cents.validate(0.3));
+	CHECK(cents.validate(19.99));
+	CHECK(cents.validate(-1234567.89));
+	CHECK(cents.validate(0.0));
+	CHECK_FALSE(cents.validate(0.305));
+	CHECK_FALSE(cents.validate(std::numeric_limits<double>::quiet_NaN()));
+	CHECK_FALSE(cents.validate(std::numeric_limits<double>::infinity()));
+	CHECK(v.number.multipleOf(0.1f).validate(0.3f));
+	CHECK(v.number.multipleOf(2.5, 0.01).validate(10.02));
+	CHECK_FALSE(v.number.multipleOf(2.5, 0.0001).validate(10.02));
+	CHECK(v.number.multipleOf(0.0).validate(0.0));
+	CHECK_FALSE(v.number.multipleOf(0.0).validate(1.0));
+
+	std::vector<std::string> errors;
+	CHECK_FALSE(cents.validate(0.305, "price", errors));
+	CHECK(errors == std::vector<std::string>{"ValidationError: 'price' received 0.305, expected multiple of 0.01."});
+
+	checkBatch(cents, batchTestValues<double>());
+	checkBatch(v.number.multipleOf(0.5f), batchTestValues<float>());
+}
+
+template <typename T> static void checkLiteralLookup(const std::vector<T>& lits, ELiteralLookup expected)
+{
+	Validator v;
+	auto validator = v.number.literals<T>(lits);
+	CHECK(validator.getLookup() == expected);
+	std::vector<T> probes = batchTestValues<T>();
+	for (T lit : lits)
+	{
+		probes.push_back(lit);
+		if (lit > std::numeric_limits<T>::lowest()) probes.push_back(static_cast<T>(lit - 1));
+		if (lit < std::numeric_limits<T>::max()) probes.push_back(static_cast<T>(lit + 1));
+	}
+	bool bSame = true;
+	for (T value : probes)
+		bSame = bSame && validator.validate(value) == (std::find(lits.begin(), lits.end(), value) != lits.end());
+	CHECK(bSame);
+	checkBatch(validator, probes);
+
+	// Forced lookups, as compared by the benchmark, agree with the chosen one
+	for (ELiteralLookup lookup : {ELiteralLookup::Scan, ELiteralLookup::Sorted, ELiteralLookup::Hash})
+	{
+		const NumberLiteralValidator<T> forced(lits, lookup);
+		CHECK(forced.getLookup() == (lits.empty() ? ELiteralLookup::Scan : lookup));
+		bool bForcedSame = true;
+		for (T value : probes) bForcedSame = bForcedSame && forced.validate(value) == validator.validate(value);
+		CHECK(bForcedSame);
+	}
+}
+
+template <typename T> static void checkLiteralLookups()
+{
+	std::mt19937_64 random(3);
+	auto randomSet = [&](size_t size)
+	{
+		std::vector<T> lits;
+		for (size_t i = 0; i < size; ++i) lits.push_back(static_cast<T>(random()));
+		return lits;
+	};
+	const T low = std::numeric_limits<T>::lowest();
+	const T high = std::numeric_limits<T>::max();
+	checkLiteralLookup<T>({}, ELiteralLookup::Scan);
+	checkLiteralLookup<T>({T(7), T(7)}, ELiteralLookup::Scan);
+	checkLiteralLookup<T>({T(5), T(1), T(3), T(9), T(7), T(1)}, ELiteralLookup::Bitmap);
+	checkLiteralLookup<T>({low, high, T(0), T(1), T(2), T(3)}, ELiteralLookup::Sorted);
+	checkLiteralLookup<T>(randomSet(12), ELiteralLookup::Sorted);
+	checkLiteralLookup<T>(randomSet(100), ELiteralLookup::Hash);
+	std::vector<T> withLimits = randomSet(1000);
+	withLimits.insert(withLimits.end(), {low, high, T(0)});
+	checkLiteralLookup<T>(withLimits, ELiteralLookup::Hash);
+	std::vector<T> dense;
+	for (int i = 0; i < 300; ++i) dense.push_back(static_cast<T>(std::is_signed_v<T> ? i * 3 - 400 : i * 3));
+	checkLiteralLookup<T>(dense, ELiteralLookup::Bitmap);
+}
+
+TEST_CASE("NumberLiteralValidator - Lookup Structures")
+{
+	checkLiteralLookups<int16_t>();
+	checkLiteralLookups<int32_t>();
+	checkLiteralLookups<uint32_t>();
+	checkLiteralLookups<int64_t>();
+	checkLiteralLookups<uint64_t>();
+
+	// Floating point sets are searched, NaN never matches and -0.0 matches 0.0
+	Validator v;
+	const double nan = std::numeric_limits<double>::quiet_NaN();
+	auto rates = v.number.literals<double>({0.0, 0.5, 1.0, 1.5, 2.0, nan, -1.0, 10.0});
+	CHECK(rates.getLookup() == ELiteralLookup::Sorted);
+	CHECK(NumberLiteralValidator<double>({0.5, 1.5, 2.5}, ELiteralLookup::Hash).getLookup() == ELiteralLookup::Sorted);
+	CHECK(rates.validate(-0.0));
+	CHECK(rates.validate(10.0));
+	CHECK_FALSE(rates.validate(0.25));
+	CHECK_FALSE(rates.validate(nan));
+	CHECK_FALSE(rates.validate(100.0));
+
+	// Messages still list the literals as given
+	std::vector<std::string> errors;
+	CHECK_FALSE(v.number.literals<int>({404, 200, 500, 201}).validate(418, "status", errors));
+	CHECK(errors == std::vector<std::string>{"ValidationError: 'status' received 418, expected one of [404, 200, 500, 201]."});
+}
+
+static void checkStringLiteralLookup(const std::vector<std::string>& lits, ELiteralLookup expected)
+{
+	Validator v;
+	auto validator = v.string.literals(lits);
+	CHECK(validator.getLookup() == expected);
+	std::vector<std::string> probes = {"", "x", std::string(1, '\0'), std::string(100, 'a')};
+	for (const auto& lit : lits)
+	{
+		probes.push_back(lit);
+		probes.push_back(lit + "x");
+		if (!lit.empty())
+		{
+			probes.push_back(lit.substr(0, lit.size() - 1));
+			std::string changed = lit;
+			changed.back() = static_cast<char>(changed.back() + 1);
+			probes.push_back(changed);
+		}
+	}
+	bool bSame = true;
+	size_t before = allocationCount;
+	for (const auto& value : probes)
+		bSame = bSame && validator.validate(value) == (std::find(lits.begin(), lits.end(), value) != lits.end());
+	CHECK(allocationCount == before);
+	CHECK(bSame);
+}
+
+TEST_CASE("StringLiteralValidator - Lookup Structures")
+{
+	std::mt19937_64 random(5);
+	auto randomSet = [&](size_t size)
+	{
+		std::vector<std::string> lits;
+		for (size_t i = 0; i < size; ++i)
+		{
+			std::string lit(random() % 90, ' ');
+			for (char& c : lit) c = static_cast<char>(random() % 256);
+			lits.push_back(lit);
+		}
+		return lits;
+	};
+	checkStringLiteralLookup({}, ELiteralLookup::Scan);
+	checkStringLiteralLookup({"red", "green", "blue"}, ELiteralLookup::Scan);
+	checkStringLiteralLookup({"a", "b", "c", "d", "e", "a", ""}, ELiteralLookup::PerfectHash);
+	checkStringLiteralLookup({"", std::string("a\0b", 3), std::string(70, 'z'), std::string(71, 'z'), "SKU-000001", "SKU-000002"},
+							 ELiteralLookup::PerfectHash);
+	checkStringLiteralLookup(randomSet(100), ELiteralLookup::PerfectHash);
+	checkStringLiteralLookup(randomSet(1000), ELiteralLookup::PerfectHash);
+	std::vector<std::string> skus;
+	for (int i = 0; i < 5000; ++i) skus.push_back("SKU-" + std::to_string(100000 + i * 7));
+	checkStringLiteralLookup(skus, ELiteralLookup::PerfectHash);
+
+	// Error messages still list the literals in the order given
+	Validator v;
+	std::vector<std::string> errors;
+	auto colors = v.string.literals({"red", "green", "blue", "cyan", "magenta", "yellow"});
+	CHECK(colors.validate("yellow"));
+	CHECK_FALSE(colors.validate("black", "color", errors));
+	CHECK(errors == std::vector<std::string>{"ValidationError: 'color' received \"black\", expected one of [\"red\", \"green\", "
+											 "\"blue\", \"cyan\", \"magenta\", \"yellow\"]."});
 }
\ No newline at end of file